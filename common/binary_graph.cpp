@@ -0,0 +1,168 @@
+#include "binary_graph.hpp"   // always include corresponding header first
+
+#include <cstdio>   // std::rename
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <sys/stat.h>
+
+namespace DIMACS
+{
+namespace
+{
+char constexpr magic[4] = {'D', 'M', 'X', 'B'};
+std::uint32_t constexpr byte_order_mark = 0x01020304;
+const std::string dmx_extension = ".dmx";
+const std::string binary_extension = ".dmxb";
+
+bool ends_with(const std::string &str, const std::string &suffix)
+{
+    return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+}   // namespace
+
+std::string binary_cache_path(const std::string &dmx_filename)
+{
+    if (ends_with(dmx_filename, dmx_extension))
+    {
+        return dmx_filename + "b";
+    }
+    return dmx_filename + binary_extension;
+}
+
+bool is_binary_path(const std::string &filename)
+{
+    return ends_with(filename, binary_extension);
+}
+
+SourceStamp source_stamp(const std::string &filename)
+{
+    struct stat info;
+    if (::stat(filename.c_str(), &info) != 0)
+    {
+        throw std::runtime_error("Could not open input file.");
+    }
+
+    SourceStamp stamp;
+    stamp.size = static_cast<std::uint64_t>(info.st_size);
+    stamp.mtime = static_cast<std::int64_t>(info.st_mtim.tv_sec);
+    stamp.mtime_nsec = static_cast<std::int64_t>(info.st_mtim.tv_nsec);
+    return stamp;
+}
+
+BinaryHeader make_header(BinaryKind kind,
+                         std::uint32_t id_bytes,
+                         std::uint32_t record_bytes,
+                         std::uint64_t num_nodes,
+                         std::uint64_t num_edges,
+                         SourceStamp const &source)
+{
+    BinaryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = binary_version;
+    header.byte_order = byte_order_mark;
+    header.id_bytes = id_bytes;
+    header.kind = static_cast<std::uint32_t>(kind);
+    header.record_bytes = record_bytes;
+    header.num_nodes = num_nodes;
+    header.num_edges = num_edges;
+    header.source_size = source.size;
+    header.source_mtime = source.mtime;
+    header.source_mtime_nsec = source.mtime_nsec;
+    return header;
+}
+
+void write_binary(const std::string &filename, BinaryHeader const &header, std::vector<BinaryBlock> const &blocks)
+{
+    std::string tmp_filename = filename + ".tmp";
+    {
+        std::ofstream ofs(tmp_filename, std::ios::binary | std::ios::trunc);
+        if (!ofs.is_open())
+        {
+            throw std::runtime_error("Could not open output file.");
+        }
+
+        static char const zeros[8] = {};
+        ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        for (auto const &block : blocks)
+        {
+            ofs.write(static_cast<const char *>(block.first), static_cast<std::streamsize>(block.second));
+            // Keep the next array 8 byte aligned.
+            ofs.write(zeros, static_cast<std::streamsize>((8 - block.second % 8) % 8));
+        }
+
+        if (!ofs)
+        {
+            throw std::runtime_error("Could not write output file.");
+        }
+    }
+
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+    {
+        std::remove(tmp_filename.c_str());
+        throw std::runtime_error("Could not write output file.");
+    }
+}
+
+std::shared_ptr<const MappedFile> map_binary(const std::string &filename,
+                                             BinaryKind kind,
+                                             std::uint32_t id_bytes,
+                                             std::uint32_t record_bytes,
+                                             std::size_t (*payload_size)(BinaryHeader const &))
+{
+    auto file = std::make_shared<const MappedFile>(filename);
+    if (file->size() < sizeof(BinaryHeader))
+    {
+        throw std::runtime_error("Binary graph file is truncated.");
+    }
+
+    BinaryHeader const &header = binary_header(*file);
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+    {
+        throw std::runtime_error("Not a binary graph file.");
+    }
+    if (header.version != binary_version || header.byte_order != byte_order_mark)
+    {
+        throw std::runtime_error("Binary graph file was written by an incompatible version or machine.");
+    }
+    if (header.kind != static_cast<std::uint32_t>(kind) || header.id_bytes != id_bytes ||
+        header.record_bytes != record_bytes)
+    {
+        throw std::runtime_error("Binary graph file has an unexpected layout.");
+    }
+    if (file->size() != sizeof(BinaryHeader) + payload_size(header))
+    {
+        throw std::runtime_error("Binary graph file is truncated.");
+    }
+
+    return file;
+}
+
+BinaryHeader const &binary_header(MappedFile const &file)
+{
+    return *reinterpret_cast<BinaryHeader const *>(file.begin());
+}
+
+std::string find_fresh_cache(const std::string &dmx_filename, BinaryKind kind, std::uint32_t id_bytes)
+{
+    std::string cache = binary_cache_path(dmx_filename);
+
+    std::ifstream ifs(cache, std::ios::binary);
+    BinaryHeader header;
+    if (!ifs.read(reinterpret_cast<char *>(&header), sizeof(header)))
+    {
+        return std::string();
+    }
+
+    SourceStamp current = source_stamp(dmx_filename);
+    bool fresh = std::memcmp(header.magic, magic, sizeof(magic)) == 0 && header.version == binary_version &&
+                 header.byte_order == byte_order_mark && header.kind == static_cast<std::uint32_t>(kind) &&
+                 header.id_bytes == id_bytes && header.source_size == current.size &&
+                 header.source_mtime == current.mtime && header.source_mtime_nsec == current.mtime_nsec;
+
+    return fresh ? cache : std::string();
+}
+
+}   // namespace DIMACS
@@ -0,0 +1,161 @@
+#ifndef COMMON_BINARY_GRAPH_HPP
+#define COMMON_BINARY_GRAPH_HPP
+
+/**
+   @file binary_graph.hpp
+
+   @brief This file describes the versioned binary graph format (@c .dmxb) that caches a parsed DIMACS file.
+
+   A @c .dmxb file consists of a 64 byte @c BinaryHeader followed by raw arrays in native byte order. Which arrays
+   follow depends on the @c BinaryKind (see @c ED::Graph and @c MMWC::Graph). Every array starts at a multiple of
+   8 bytes, so the arrays can be used in place after mapping the file.
+
+   The header records the size and modification time (in nanoseconds) of the @c .dmx file it was created from. A cache is fresh if
+   both still match, in which case it can be used instead of parsing the text file.
+**/
+
+#include <cstddef>   // std::size_t
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mapped_file.hpp"
+
+namespace DIMACS
+{
+std::uint32_t constexpr binary_version = 2;
+
+//! Which program's graph layout follows the header.
+enum class BinaryKind : std::uint32_t
+{
+    adjacency = 1,     //!< @c ED::Graph: offsets, neighbors
+    capacitated = 2,   //!< @c MMWC::Graph: offsets, incident edge ids, edges (with capacities)
+    checkpoint = 3     //!< state of @c ED::EdmondsMatching: phi, mu, rho, flags, engine (see edmonds.cpp)
+};
+
+//! Identifies the version of a @c .dmx file a cache was created from.
+struct SourceStamp
+{
+    std::uint64_t size = 0;
+    std::int64_t mtime = 0;        //!< seconds
+    std::int64_t mtime_nsec = 0;   //!< nanoseconds within the second, so rewrites within one second are noticed
+};
+
+struct BinaryHeader
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t byte_order;   //!< @c 0x01020304 as written by the creating machine
+    std::uint32_t id_bytes;     //!< size of one node or edge id
+    std::uint32_t kind;         //!< a @c BinaryKind
+    std::uint32_t record_bytes; //!< size of one record of the kind-specific record array (0 if there is none)
+    std::uint64_t num_nodes;
+    std::uint64_t num_edges;
+    std::uint64_t source_size;
+    std::int64_t source_mtime;
+    std::int64_t source_mtime_nsec;
+};
+
+static_assert(sizeof(BinaryHeader) == 64, "The binary header must stay 64 bytes long.");
+
+//! A block of raw bytes to be written after the header.
+using BinaryBlock = std::pair<const void *, std::size_t>;
+
+/** @return The path of the cache belonging to @c dmx_filename (@c foo.dmx becomes @c foo.dmxb). **/
+std::string binary_cache_path(const std::string &dmx_filename);
+
+/** @return True if @c filename ends with @c .dmxb. **/
+bool is_binary_path(const std::string &filename);
+
+/** @return The current stamp of @c filename. Throws if the file does not exist. **/
+SourceStamp source_stamp(const std::string &filename);
+
+/**
+   @return A header for a graph of the given kind and size, created from a file with stamp @c source.
+**/
+BinaryHeader make_header(BinaryKind kind,
+                         std::uint32_t id_bytes,
+                         std::uint32_t record_bytes,
+                         std::uint64_t num_nodes,
+                         std::uint64_t num_edges,
+                         SourceStamp const &source);
+
+/**
+   @brief Writes @c header followed by @c blocks to @c filename.
+
+   The file is written under a temporary name and renamed afterwards, so readers never see a partial file.
+**/
+void write_binary(const std::string &filename, BinaryHeader const &header, std::vector<BinaryBlock> const &blocks);
+
+/**
+   @brief Maps @c filename and checks its header against the expected layout.
+
+   Only the header and the total file size (which has to be the header plus @c payload_size(header)) are checked, the
+   callers check the arrays (see @c check_csr). Throws if the file is not a valid cache of the expected kind.
+**/
+std::shared_ptr<const MappedFile> map_binary(const std::string &filename,
+                                             BinaryKind kind,
+                                             std::uint32_t id_bytes,
+                                             std::uint32_t record_bytes,
+                                             std::size_t (*payload_size)(BinaryHeader const &));
+
+/** @return The header at the start of a file returned by @c map_binary. **/
+BinaryHeader const &binary_header(MappedFile const &file);
+
+/**
+   @return The path of a fresh cache of @c dmx_filename of the given kind and id size, or the empty string if there is
+   none. A cache written with another id size (see index_type.hpp) is not used.
+**/
+std::string find_fresh_cache(const std::string &dmx_filename, BinaryKind kind, std::uint32_t id_bytes);
+
+/**
+   @brief Throws unless the arrays of a mapped compressed sparse row structure are consistent: @c offsets (of
+   @c num_nodes + 1 entries) starts at 0, never decreases and ends at @c num_entries, and each of the @c num_entries
+   entries of @c ids is below @c id_bound.
+
+   @c map_binary checks only the sizes, so without this a corrupt cache would be read out of bounds. Takes
+   O(num_nodes + num_entries) time.
+**/
+template <typename Id>
+void check_csr(const std::size_t *offsets,
+               std::uint64_t num_nodes,
+               const Id *ids,
+               std::uint64_t num_entries,
+               std::uint64_t id_bound)
+{
+    bool valid = offsets[0] == 0 && offsets[num_nodes] == num_entries;
+    for (std::uint64_t v = 0; valid && v < num_nodes; ++v)
+    {
+        valid = offsets[v] <= offsets[v + 1];
+    }
+    for (std::uint64_t i = 0; valid && i < num_entries; ++i)
+    {
+        valid = static_cast<std::uint64_t>(ids[i]) < id_bound;
+    }
+    if (!valid)
+    {
+        throw std::runtime_error("Binary graph file is corrupt.");
+    }
+}
+
+/** @return The number of bytes an array of @c bytes bytes occupies in the file (including alignment padding). **/
+inline std::size_t aligned_size(std::size_t bytes)
+{
+    return (bytes + 7) / 8 * 8;
+}
+
+/**
+   @return A typed pointer to the array that starts @c offset bytes after the header of a mapped file.
+**/
+template <typename T>
+const T *binary_array(MappedFile const &file, std::size_t offset)
+{
+    return reinterpret_cast<const T *>(file.begin() + sizeof(BinaryHeader) + offset);
+}
+
+}   // namespace DIMACS
+
+#endif   // COMMON_BINARY_GRAPH_HPP
@@ -0,0 +1,278 @@
+#ifndef COMMON_DIMACS_PARSER_HPP
+#define COMMON_DIMACS_PARSER_HPP
+
+/**
+   @file dimacs_parser.hpp
+
+   @brief This file provides an allocation-free parser for DIMACS graph files held in memory (e.g. a @c MappedFile).
+
+   The parser understands the subset of the format used by both programs: comment lines starting with @c c, exactly
+   one problem line <tt>p <format> <num_nodes> <num_edges></tt> before any other content, and edge lines
+   <tt>e <node1> <node2> [<capacity>]</tt>. All other lines after the problem line are ignored.
+**/
+
+#include <cstddef>   // std::size_t
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace DIMACS
+{
+/**
+   @class Parser
+
+   @brief Scans a character range line by line without copying it.
+
+   Integers are read with a hand-written scanner, so no locale, stream or string is involved.
+**/
+class Parser
+{
+  public:
+    /**
+       @brief Creates a parser for the characters in <tt> [begin, end) </tt>, which have to outlive the parser.
+    **/
+    Parser(const char *begin, const char *end);
+
+    /**
+       @brief Skips all comment lines and reads the problem line.
+       Throws if the first non-comment line is not a problem line.
+    **/
+    void read_problem_line(std::size_t &num_nodes, std::size_t &num_edges);
+
+    /**
+       @brief Reads the next edge line.
+       @return False if there are no more edge lines.
+    **/
+    bool next_edge(std::size_t &node1, std::size_t &node2);
+
+    /**
+       @brief Reads the next edge line including its (possibly negative) capacity column.
+       @return False if there are no more edge lines.
+    **/
+    bool next_edge(std::size_t &node1, std::size_t &node2, long &cap);
+
+    /** @return The current read position, i.e. the start of the line that will be scanned next. **/
+    const char *position() const;
+
+  private:
+    /** Moves past the end of the current line. **/
+    void skip_line();
+
+    /** Moves past blanks, but not past the end of the line. **/
+    void skip_blanks();
+
+    /** Moves to the start of the next edge line and past its @c e. **/
+    bool find_edge_line();
+
+    std::size_t read_unsigned();
+    long read_signed();
+
+    [[noreturn]] void malformed() const;
+
+    const char *_cur;
+    const char *_end;
+};
+
+//! A range of whole lines <tt> [first, second) </tt>.
+using LineRange = std::pair<const char *, const char *>;
+
+/**
+   @brief Splits <tt> [begin, end) </tt> into at least one and at most @c max_chunks ranges of roughly equal size, each
+   consisting of whole lines, so that each range can be scanned by its own @c Parser. Chunks are not made smaller
+   than @c min_chunk_bytes on purpose, so small inputs yield fewer chunks.
+**/
+std::vector<LineRange> split_lines(const char *begin,
+                                   const char *end,
+                                   std::size_t max_chunks,
+                                   std::size_t min_chunk_bytes = 1 << 16);
+
+// BEGIN: Inline section
+
+inline Parser::Parser(const char *begin, const char *end) : _cur(begin), _end(end) {}
+
+inline const char *Parser::position() const
+{
+    return _cur;
+}
+
+inline void Parser::skip_line()
+{
+    while (_cur != _end && *_cur != '\n')
+    {
+        ++_cur;
+    }
+    if (_cur != _end)
+    {
+        ++_cur;
+    }
+}
+
+inline void Parser::skip_blanks()
+{
+    while (_cur != _end && (*_cur == ' ' || *_cur == '\t' || *_cur == '\r'))
+    {
+        ++_cur;
+    }
+}
+
+inline std::size_t Parser::read_unsigned()
+{
+    skip_blanks();
+    if (_cur == _end || *_cur < '0' || *_cur > '9')
+    {
+        malformed();
+    }
+
+    // Larger numbers would wrap around to small ones, e.g. to valid node ids.
+    std::size_t constexpr max_value = std::numeric_limits<std::size_t>::max();
+    std::size_t value = 0;
+    do
+    {
+        std::size_t const digit = static_cast<std::size_t>(*_cur - '0');
+        if (value > (max_value - digit) / 10)
+        {
+            malformed();
+        }
+        value = value * 10 + digit;
+        ++_cur;
+    } while (_cur != _end && *_cur >= '0' && *_cur <= '9');
+
+    return value;
+}
+
+inline long Parser::read_signed()
+{
+    skip_blanks();
+    bool negative = false;
+    if (_cur != _end && (*_cur == '-' || *_cur == '+'))
+    {
+        negative = (*_cur == '-');
+        ++_cur;
+    }
+    std::size_t const magnitude = read_unsigned();
+    if (magnitude > static_cast<std::size_t>(std::numeric_limits<long>::max()))
+    {
+        malformed();
+    }
+    long value = static_cast<long>(magnitude);
+    return negative ? -value : value;
+}
+
+inline bool Parser::find_edge_line()
+{
+    while (_cur != _end)
+    {
+        if (*_cur == 'e')
+        {
+            ++_cur;
+            return true;
+        }
+        skip_line();
+    }
+    return false;
+}
+
+inline bool Parser::next_edge(std::size_t &node1, std::size_t &node2)
+{
+    if (!find_edge_line())
+    {
+        return false;
+    }
+    node1 = read_unsigned();
+    node2 = read_unsigned();
+    skip_line();
+    return true;
+}
+
+inline bool Parser::next_edge(std::size_t &node1, std::size_t &node2, long &cap)
+{
+    if (!find_edge_line())
+    {
+        return false;
+    }
+    node1 = read_unsigned();
+    node2 = read_unsigned();
+    cap = read_signed();
+    skip_line();
+    return true;
+}
+
+inline void Parser::read_problem_line(std::size_t &num_nodes, std::size_t &num_edges)
+{
+    while (_cur != _end && *_cur == 'c')
+    {
+        skip_line();
+    }
+    if (_cur == _end)
+    {
+        throw std::runtime_error("Could not find problem line in DIMACS stream.");
+    }
+    if (*_cur != 'p')
+    {
+        throw std::runtime_error("Unexpected format of input file.");
+    }
+    ++_cur;
+
+    // Skip the format word (e.g. "edge"), we do not care about it.
+    skip_blanks();
+    while (_cur != _end && *_cur != ' ' && *_cur != '\t' && *_cur != '\n')
+    {
+        ++_cur;
+    }
+
+    num_nodes = read_unsigned();
+    num_edges = read_unsigned();
+    skip_line();
+}
+
+inline void Parser::malformed() const
+{
+    throw std::runtime_error("Malformed line in DIMACS stream.");
+}
+
+inline std::vector<LineRange> split_lines(const char *begin,
+                                          const char *end,
+                                          std::size_t max_chunks,
+                                          std::size_t min_chunk_bytes)
+{
+    std::size_t const total = static_cast<std::size_t>(end - begin);
+    std::size_t num_chunks = min_chunk_bytes == 0 ? max_chunks : total / min_chunk_bytes;
+    if (num_chunks > max_chunks)
+    {
+        num_chunks = max_chunks;
+    }
+    if (num_chunks == 0)
+    {
+        num_chunks = 1;
+    }
+
+    std::vector<LineRange> chunks;
+    const char *start = begin;
+    for (std::size_t i = 1; i <= num_chunks && start != end; ++i)
+    {
+        const char *stop = (i == num_chunks) ? end : begin + total / num_chunks * i;
+        if (stop < start)
+        {
+            stop = start;
+        }
+        // Move the split point behind the end of the line it falls into.
+        while (stop != end && stop != begin && *(stop - 1) != '\n')
+        {
+            ++stop;
+        }
+        chunks.emplace_back(start, stop);
+        start = stop;
+    }
+    if (chunks.empty())
+    {
+        chunks.emplace_back(begin, end);
+    }
+
+    return chunks;
+}
+
+// END: Inline section
+}   // namespace DIMACS
+
+#endif   // COMMON_DIMACS_PARSER_HPP
@@ -0,0 +1,155 @@
+#include "dimacs_writer.hpp"   // always include corresponding header first
+
+#include <cerrno>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace DIMACS
+{
+namespace
+{
+std::size_t constexpr buffer_size = 1 << 20;
+std::size_t constexpr window_size = 1 << 24;
+
+std::size_t page_size()
+{
+    static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+}   // namespace
+
+Writer::Writer(int fd) : _fd(fd), _owns_fd(false), _mode(Mode::buffered), _buffer(buffer_size)
+{
+    _data = _buffer.data();
+    _capacity = _buffer.size();
+}
+
+Writer::Writer(const std::string &filename, Mode mode) : _fd(-1), _owns_fd(true), _mode(mode)
+{
+    int flags = (mode == Mode::mapped ? O_RDWR : O_WRONLY) | O_CREAT | O_TRUNC;
+    _fd = ::open(filename.c_str(), flags, 0644);
+    if (_fd < 0)
+    {
+        throw std::runtime_error("Could not open output file.");
+    }
+
+    if (_mode == Mode::buffered)
+    {
+        _buffer.resize(buffer_size);
+        _data = _buffer.data();
+        _capacity = _buffer.size();
+    }
+    else
+    {
+        map_window(0);
+    }
+}
+
+Writer::~Writer()
+{
+    try
+    {
+        close();
+    }
+    catch (...)
+    {
+        // Nobody to report to, close() has to be called explicitly to see errors.
+    }
+}
+
+void Writer::map_window(std::size_t bytes)
+{
+    std::size_t size = bytes > window_size ? bytes : window_size;
+    size = (size + _pos + page_size() - 1) / page_size() * page_size();
+
+    if (::ftruncate(_fd, static_cast<off_t>(_window_offset + size)) != 0)
+    {
+        throw std::runtime_error("Could not grow output file.");
+    }
+    void *addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, static_cast<off_t>(_window_offset));
+    if (addr == MAP_FAILED)
+    {
+        throw std::runtime_error("Could not map output file.");
+    }
+    _data = static_cast<char *>(addr);
+    _capacity = size;
+}
+
+void Writer::flush(std::size_t bytes)
+{
+    if (_closed)
+    {
+        throw std::runtime_error("Writing to a closed writer.");
+    }
+
+    if (_mode == Mode::buffered)
+    {
+        std::size_t written = 0;
+        while (written < _pos)
+        {
+            ssize_t result = ::write(_fd, _data + written, _pos - written);
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::runtime_error("Could not write output.");
+            }
+            written += static_cast<std::size_t>(result);
+        }
+        _pos = 0;
+        if (bytes > _capacity)
+        {
+            _buffer.resize(bytes);
+            _data = _buffer.data();
+            _capacity = _buffer.size();
+        }
+        return;
+    }
+
+    // Move the window forward. It has to start at a page boundary, so the last partial page is mapped again and the
+    // bytes already written to it stay in front of the new write position.
+    std::size_t end = _window_offset + _pos;
+    ::munmap(_data, _capacity);
+    _data = nullptr;
+    _window_offset = end / page_size() * page_size();
+    _pos = end - _window_offset;
+    map_window(bytes);
+}
+
+void Writer::close()
+{
+    if (_closed)
+    {
+        return;
+    }
+
+    if (_mode == Mode::buffered)
+    {
+        flush(0);
+    }
+    else if (_data != nullptr)
+    {
+        ::munmap(_data, _capacity);
+        _data = nullptr;
+        // Cut off the unused rest of the last window.
+        if (::ftruncate(_fd, static_cast<off_t>(_window_offset + _pos)) != 0)
+        {
+            _closed = true;
+            ::close(_fd);
+            throw std::runtime_error("Could not truncate output file.");
+        }
+    }
+    _closed = true;
+
+    if (_owns_fd && ::close(_fd) != 0)
+    {
+        throw std::runtime_error("Could not close output file.");
+    }
+}
+
+}   // namespace DIMACS
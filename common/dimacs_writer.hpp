@@ -0,0 +1,144 @@
+#ifndef COMMON_DIMACS_WRITER_HPP
+#define COMMON_DIMACS_WRITER_HPP
+
+/**
+   @file dimacs_writer.hpp
+
+   @brief This file provides a buffered writer for DIMACS output that formats integers by hand.
+
+   Output is collected in a large buffer and handed to the kernel with @c write(2) in big blocks, or written directly
+   into a memory-mapped output file. No iostreams or locales are involved.
+**/
+
+#include <cstddef>   // std::size_t
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace DIMACS
+{
+/**
+   @class Writer
+
+   @brief Writes characters, strings and integers to a file descriptor or a file.
+
+   Call @c close() to detect errors; the destructor also finishes the output but has to swallow errors.
+**/
+class Writer
+{
+  public:
+    enum class Mode
+    {
+        buffered,   //!< collect output in a buffer and flush it with @c write(2)
+        mapped      //!< write directly into the file through a growing memory mapping
+    };
+
+    /**
+       @brief Writes to the already open file descriptor @c fd (e.g. 1 for stdout), which is not closed.
+    **/
+    explicit Writer(int fd);
+
+    /**
+       @brief Creates (or truncates) @c filename and writes to it in the given mode.
+    **/
+    Writer(const std::string &filename, Mode mode);
+
+    Writer(const Writer &) = delete;
+    Writer &operator=(const Writer &) = delete;
+
+    ~Writer();
+
+    void put(char c);
+    void put(const char *str);
+    void put_unsigned(std::uint64_t value);
+    void put_signed(std::int64_t value);
+
+    /** @brief Writes out everything and releases the output. Throws on errors. **/
+    void close();
+
+  private:
+    //! Longest output of a single @c put_* call for integers (sign and 20 digits).
+    static std::size_t constexpr max_number_length = 21;
+
+    /** Makes sure at least @c bytes bytes can be appended to the buffer. **/
+    void reserve(std::size_t bytes);
+
+    /** Hands the buffer to the output and makes room for at least @c bytes bytes. **/
+    void flush(std::size_t bytes);
+
+    /** Maps the window of the output file starting at @c _window_offset with room for @c bytes bytes. **/
+    void map_window(std::size_t bytes);
+
+    int _fd;
+    bool _owns_fd;
+    Mode _mode;
+    bool _closed = false;
+
+    std::vector<char> _buffer;   //!< only used in buffered mode
+    char *_data = nullptr;       //!< start of the buffer or the mapped window
+    std::size_t _pos = 0;        //!< number of bytes in the buffer or window
+    std::size_t _capacity = 0;   //!< size of the buffer or window
+
+    std::size_t _window_offset = 0;   //!< file offset of the mapped window (page aligned)
+};
+
+// BEGIN: Inline section
+
+inline void Writer::reserve(std::size_t bytes)
+{
+    if (_capacity - _pos < bytes)
+    {
+        flush(bytes);
+    }
+}
+
+inline void Writer::put(char c)
+{
+    reserve(1);
+    _data[_pos++] = c;
+}
+
+inline void Writer::put(const char *str)
+{
+    std::size_t length = std::strlen(str);
+    reserve(length);
+    std::memcpy(_data + _pos, str, length);
+    _pos += length;
+}
+
+inline void Writer::put_unsigned(std::uint64_t value)
+{
+    reserve(max_number_length);
+
+    // Write the digits backwards into a scratch buffer, then copy them in the right order.
+    char digits[max_number_length];
+    std::size_t length = 0;
+    do
+    {
+        digits[max_number_length - 1 - length] = static_cast<char>('0' + value % 10);
+        value /= 10;
+        ++length;
+    } while (value != 0);
+
+    std::memcpy(_data + _pos, digits + max_number_length - length, length);
+    _pos += length;
+}
+
+inline void Writer::put_signed(std::int64_t value)
+{
+    if (value < 0)
+    {
+        put('-');
+        put_unsigned(static_cast<std::uint64_t>(0) - static_cast<std::uint64_t>(value));
+    }
+    else
+    {
+        put_unsigned(static_cast<std::uint64_t>(value));
+    }
+}
+
+// END: Inline section
+}   // namespace DIMACS
+
+#endif   // COMMON_DIMACS_WRITER_HPP
@@ -0,0 +1,44 @@
+#ifndef COMMON_INDEX_TYPE_HPP
+#define COMMON_INDEX_TYPE_HPP
+
+/**
+   @file index_type.hpp
+
+   @brief This file defines the integer type of the node and edge ids of both programs.
+
+   It is @c std::size_t by default. Building with @c DIMACS_INDEX32 defined (<tt>cmake -DINDEX32=ON</tt>) makes it
+   @c std::uint32_t instead, which halves the adjacency arrays and every array of ids, e.g. the state of the matching
+   search and the metric closure of @c MMWC::TJoin. The largest value is reserved for invalid ids, so graphs with
+   2^32 - 1 or more nodes or edges do not fit and are rejected when they are loaded (see @c check_id_range).
+**/
+
+#include <cstddef>   // std::size_t
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace DIMACS
+{
+#ifdef DIMACS_INDEX32
+using Index = std::uint32_t;
+#else
+using Index = std::size_t;
+#endif
+
+/**
+   @brief Throws unless the ids 0, ..., @c count - 1 all fit into an @c Index below its largest value.
+   @param what Names the ids in the message, e.g. "nodes".
+**/
+inline void check_id_range(std::uint64_t count, const char *what)
+{
+    if (count >= static_cast<std::uint64_t>(std::numeric_limits<Index>::max()))
+    {
+        throw std::runtime_error("The graph has too many " + std::string(what) + " for " +
+                                 std::to_string(8 * sizeof(Index)) + "-bit ids.");
+    }
+}
+
+}   // namespace DIMACS
+
+#endif   // COMMON_INDEX_TYPE_HPP
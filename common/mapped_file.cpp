@@ -0,0 +1,78 @@
+#include "mapped_file.hpp"   // always include corresponding header first
+
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace DIMACS
+{
+MappedFile::MappedFile(const std::string &filename)
+{
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Could not open input file.");
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("Could not determine size of input file.");
+    }
+
+    _size = static_cast<std::size_t>(info.st_size);
+    if (_size > 0)
+    {
+        void *addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED)
+        {
+            ::close(fd);
+            throw std::runtime_error("Could not map input file.");
+        }
+        // We parse front to back exactly once, so let the kernel read ahead aggressively.
+        ::madvise(addr, _size, MADV_SEQUENTIAL);
+        _data = static_cast<const char *>(addr);
+    }
+
+    // The mapping stays valid after the descriptor is closed.
+    ::close(fd);
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept : _data(other._data), _size(other._size)
+{
+    other._data = nullptr;
+    other._size = 0;
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+void MappedFile::unmap()
+{
+    if (_data != nullptr)
+    {
+        ::munmap(const_cast<char *>(_data), _size);
+        _data = nullptr;
+        _size = 0;
+    }
+}
+
+}   // namespace DIMACS
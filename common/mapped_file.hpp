@@ -0,0 +1,74 @@
+#ifndef COMMON_MAPPED_FILE_HPP
+#define COMMON_MAPPED_FILE_HPP
+
+/**
+   @file mapped_file.hpp
+
+   @brief This file provides a small RAII wrapper around a read-only memory mapping of a whole file.
+**/
+
+#include <cstddef>   // std::size_t
+#include <string>
+
+namespace DIMACS
+{
+/**
+   @class MappedFile
+
+   @brief Maps a file read-only into memory for the lifetime of the object.
+
+   An empty file is represented by an empty range (@c begin() == @c end()) since it cannot be mapped.
+**/
+class MappedFile
+{
+  public:
+    /**
+       @brief Opens and maps the file @c filename. Throws if the file cannot be opened or mapped.
+    **/
+    explicit MappedFile(const std::string &filename);
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    ~MappedFile();
+
+    /** @return Pointer to the first byte of the file. **/
+    const char *begin() const;
+
+    /** @return Pointer one past the last byte of the file. **/
+    const char *end() const;
+
+    /** @return The size of the file in bytes. **/
+    std::size_t size() const;
+
+  private:
+    void unmap();
+
+    const char *_data = nullptr;
+    std::size_t _size = 0;
+};
+
+// BEGIN: Inline section
+
+inline const char *MappedFile::begin() const
+{
+    return _data;
+}
+
+inline const char *MappedFile::end() const
+{
+    return _data + _size;
+}
+
+inline std::size_t MappedFile::size() const
+{
+    return _size;
+}
+
+// END: Inline section
+}   // namespace DIMACS
+
+#endif   // COMMON_MAPPED_FILE_HPP
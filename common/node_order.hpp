@@ -0,0 +1,171 @@
+#ifndef COMMON_NODE_ORDER_HPP
+#define COMMON_NODE_ORDER_HPP
+
+/**
+   @file node_order.hpp
+
+   @brief This file provides orders of the nodes of a graph in which neighbors tend to get nearby ids, so that the
+   arrays indexed by node id are accessed with better locality once the graph is renumbered in that order.
+**/
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "index_type.hpp"
+
+namespace DIMACS
+{
+enum class NodeOrder
+{
+    none,     //!< Keep the ids of the input.
+    bfs,      //!< Breadth-first search from the smallest unvisited node of every component.
+    rcm,      //!< Reverse Cuthill-McKee.
+    degree    //!< Decreasing degree, so that the nodes scanned most often share cache lines.
+};
+
+/**
+   @return The order called @c name ("none", "bfs", "rcm" or "degree"), throws for any other name.
+**/
+inline NodeOrder parse_node_order(const std::string &name)
+{
+    if (name == "none")
+    {
+        return NodeOrder::none;
+    }
+    if (name == "bfs")
+    {
+        return NodeOrder::bfs;
+    }
+    if (name == "rcm")
+    {
+        return NodeOrder::rcm;
+    }
+    if (name == "degree")
+    {
+        return NodeOrder::degree;
+    }
+    throw std::runtime_error("Unknown node order " + name + ".");
+}
+
+/**
+   @return The nodes of @c graph sorted by degree (decreasing if @c decreasing is set), nodes of equal degree by id.
+   Takes O(n + maximum degree) time.
+**/
+template <typename Adjacency>
+std::vector<Index> nodes_by_degree(const Adjacency &graph, bool decreasing)
+{
+    Index const num_nodes = graph.num_nodes();
+    std::size_t max_degree = 0;
+    for (Index v = 0; v < num_nodes; ++v)
+    {
+        max_degree = std::max<std::size_t>(max_degree, graph.degree(v));
+    }
+    // Counting sort, bucket b holds the nodes of degree b (or max_degree - b).
+    std::vector<std::size_t> first(max_degree + 2, 0);
+    for (Index v = 0; v < num_nodes; ++v)
+    {
+        std::size_t const d = graph.degree(v);
+        ++first[(decreasing ? max_degree - d : d) + 1];
+    }
+    for (std::size_t b = 1; b < first.size(); ++b)
+    {
+        first[b] += first[b - 1];
+    }
+    std::vector<Index> nodes(num_nodes);
+    for (Index v = 0; v < num_nodes; ++v)
+    {
+        std::size_t const d = graph.degree(v);
+        nodes[first[decreasing ? max_degree - d : d]++] = v;
+    }
+    return nodes;
+}
+
+/**
+   @return The nodes of @c graph in the given order, i.e. the node that gets id @c i when the graph is renumbered is
+   at position @c i. @c NodeOrder::none gives the identity.
+
+   @c Adjacency is any graph type with @c num_nodes(), @c degree(v) and @c neighbor(v, i) for <tt>i < degree(v)</tt>.
+   Both searches visit every component in turn, so the nodes of a component get consecutive ids. Reverse
+   Cuthill-McKee starts every component at its node of smallest degree (instead of a pseudo-peripheral node), visits
+   the neighbors of a node by increasing degree and reverses the result. All orders take O(n + m) time, except for
+   sorting the neighbors in @c NodeOrder::rcm.
+**/
+template <typename Adjacency>
+std::vector<Index> node_order(const Adjacency &graph, NodeOrder order)
+{
+    Index const num_nodes = graph.num_nodes();
+    if (order == NodeOrder::degree)
+    {
+        return nodes_by_degree(graph, true);
+    }
+
+    std::vector<Index> nodes(num_nodes);
+    if (order == NodeOrder::none)
+    {
+        for (Index v = 0; v < num_nodes; ++v)
+        {
+            nodes[v] = v;
+        }
+        return nodes;
+    }
+
+    // The visited nodes form the queue of the search: nodes[head], ..., nodes[tail - 1] are still to be scanned.
+    std::vector<Index> const starts =
+        order == NodeOrder::rcm ? nodes_by_degree(graph, false) : std::vector<Index>();
+    std::vector<unsigned char> visited(num_nodes, false);
+    Index tail = 0;
+    for (Index s = 0; s < num_nodes; ++s)
+    {
+        Index const start = order == NodeOrder::rcm ? starts[s] : s;
+        if (visited[start])
+        {
+            continue;
+        }
+        visited[start] = true;
+        nodes[tail++] = start;
+        for (Index head = tail - 1; head < tail; ++head)
+        {
+            Index const v = nodes[head];
+            Index const first_child = tail;
+            for (std::size_t i = 0; i < graph.degree(v); ++i)
+            {
+                Index const w = graph.neighbor(v, i);
+                if (!visited[w])
+                {
+                    visited[w] = true;
+                    nodes[tail++] = w;
+                }
+            }
+            if (order == NodeOrder::rcm)
+            {
+                std::stable_sort(nodes.begin() + first_child, nodes.begin() + tail, [&graph](Index a, Index b) {
+                    return graph.degree(a) < graph.degree(b);
+                });
+            }
+        }
+    }
+    if (order == NodeOrder::rcm)
+    {
+        std::reverse(nodes.begin(), nodes.end());
+    }
+    return nodes;
+}
+
+/**
+   @return The inverse of the permutation @c nodes, i.e. the new id of every node if @c nodes is a @c node_order.
+**/
+inline std::vector<Index> inverse_order(const std::vector<Index> &nodes)
+{
+    std::vector<Index> position(nodes.size());
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+        position[nodes[i]] = static_cast<Index>(i);
+    }
+    return position;
+}
+
+}   // namespace DIMACS
+
+#endif   // COMMON_NODE_ORDER_HPP
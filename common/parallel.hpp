@@ -0,0 +1,76 @@
+#ifndef COMMON_PARALLEL_HPP
+#define COMMON_PARALLEL_HPP
+
+/**
+   @file parallel.hpp
+
+   @brief This file provides a minimal fork-join helper on top of @c std::thread.
+**/
+
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace DIMACS
+{
+/**
+   @return @c requested, or the number of hardware threads if @c requested is 0.
+**/
+inline unsigned resolve_thread_count(unsigned requested)
+{
+    if (requested != 0)
+    {
+        return requested;
+    }
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware == 0 ? 1 : hardware;
+}
+
+/**
+   @brief Calls <tt> f(0), ..., f(num_tasks - 1) </tt> on @c num_tasks threads (the calling thread runs task 0) and
+   waits for all of them.
+
+   If any task throws, the exception of the task with the smallest index is rethrown after all tasks finished.
+**/
+template <typename func>
+void run_parallel(unsigned num_tasks, func f)
+{
+    std::vector<std::exception_ptr> errors(num_tasks);
+    auto guarded = [&f, &errors](unsigned task) {
+        try
+        {
+            f(task);
+        }
+        catch (...)
+        {
+            errors[task] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_tasks);
+    for (unsigned task = 1; task < num_tasks; ++task)
+    {
+        threads.emplace_back(guarded, task);
+    }
+    if (num_tasks > 0)
+    {
+        guarded(0);
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (auto const &error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}   // namespace DIMACS
+
+#endif   // COMMON_PARALLEL_HPP
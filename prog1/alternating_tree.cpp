@@ -0,0 +1,241 @@
+#include "alternating_tree.hpp"
+
+#include "dynamic_graph.hpp"
+
+#include <cassert>
+
+namespace ED
+{
+size_type constexpr AlternatingTree::unlimited_depth;
+
+AlternatingTree::AlternatingTree(NodeId num_nodes)
+    : _label(num_nodes, Label::none),
+      _level(num_nodes, 0),
+      _phi(num_nodes),
+      _blossoms(num_nodes),
+      _base(num_nodes),
+      _truncated(false),
+      _ignored(num_nodes, false),
+      _x_marks(num_nodes),
+      _y_marks(num_nodes)
+{
+    for (NodeId v = 0; v < num_nodes; ++v)
+    {
+        _phi[v] = v;
+        _base[v] = v;
+    }
+}
+
+template <typename G>
+bool AlternatingTree::search(const G &g, std::vector<NodeId> &mu, NodeId root, size_type max_depth, NodeId blocked)
+{
+    assert(mu[root] == root && !_ignored[root]);
+    _tree.clear();
+    _queue.clear();
+    _truncated = false;
+    add_to_tree(root, Label::outer);
+    _level[root] = 0;
+    _queue.push_back(root);
+
+    bool found = false;
+    for (size_t i = 0; i < _queue.size() && !found; ++i)
+    {
+        NodeId x = _queue[i];
+        // A blossom is as far from the root as its base, so after a shrink its nodes may be closer than before.
+        size_type const level = _level[rho(x)];
+        for (auto y : g.node(x).neighbors())
+        {
+            if (y == blocked || _ignored[y])
+            {
+                continue;
+            }
+            if (_label[y] == Label::none)
+            {
+                if (mu[y] == y)
+                {
+                    augment(mu, x, y);
+                    found = true;
+                    break;
+                }
+                // Grow step, unless the tree would get deeper than max_depth matching edges. The mate of a node
+                // outside of the tree is outside of it as well.
+                if (level < max_depth)
+                {
+                    _phi[y] = x;
+                    add_to_tree(y, Label::inner);
+                    add_to_tree(mu[y], Label::outer);
+                    _level[mu[y]] = level + 1;
+                    _queue.push_back(mu[y]);
+                }
+                else
+                {
+                    _truncated = true;
+                }
+            }
+            else if (_label[y] == Label::outer && rho(x) != rho(y))
+            {
+                shrink(x, y, find_common_blossom(mu, x, y));
+            }
+        }
+    }
+
+    for (auto v : _tree)
+    {
+        _label[v] = Label::none;
+        _phi[v] = v;
+        _blossoms.reset(v);
+        _base[v] = v;
+    }
+    return found;
+}
+
+template bool AlternatingTree::search<Graph>(const Graph &, std::vector<NodeId> &, NodeId, size_type, NodeId);
+template bool AlternatingTree::search<DynamicGraph>(const DynamicGraph &,
+                                                    std::vector<NodeId> &,
+                                                    NodeId,
+                                                    size_type,
+                                                    NodeId);
+
+void AlternatingTree::ignore_tree()
+{
+    for (auto v : _tree)
+    {
+        _ignored[v] = true;
+    }
+}
+
+void AlternatingTree::add_to_tree(NodeId v, Label label)
+{
+    _label[v] = label;
+    _tree.push_back(v);
+}
+
+NodeId AlternatingTree::find_common_blossom(const std::vector<NodeId> &mu, NodeId x, NodeId y)
+{
+    _x_path.assign(1, x);
+    _y_path.assign(1, y);
+    _x_marks.clear();
+    _y_marks.clear();
+
+    // As in EdmondsMatching::find_common_blossom, except that both paths lead to the same root, so they always meet.
+    auto step = [this, &mu](std::vector<NodeId> &path, NodeMarker &own, const NodeMarker &other, bool &at_root) {
+        NodeId cur = path.back();
+        NodeId base = rho(cur);
+        if (other.is_marked(base))
+        {
+            return base;
+        }
+        own.mark(base);
+
+        NodeId next = (path.size() % 2 == 1) ? mu[cur] : _phi[cur];
+        if (next == cur)
+        {
+            at_root = true;
+        }
+        else
+        {
+            path.push_back(next);
+        }
+        return invalid_node_id;
+    };
+
+    auto cut_at_blossom = [this](std::vector<NodeId> &path, NodeId root) {
+        size_t i = 0;
+        while (rho(path[i]) != root)
+        {
+            ++i;
+        }
+        path.resize(i + 1);
+    };
+
+    bool x_at_root = false, y_at_root = false;
+    while (true)
+    {
+        assert(!x_at_root || !y_at_root);
+        NodeId root;
+        if (!x_at_root && (root = step(_x_path, _x_marks, _y_marks, x_at_root)) != invalid_node_id)
+        {
+            cut_at_blossom(_y_path, root);
+            return root;
+        }
+        if (!y_at_root && (root = step(_y_path, _y_marks, _x_marks, y_at_root)) != invalid_node_id)
+        {
+            cut_at_blossom(_x_path, root);
+            return root;
+        }
+    }
+}
+
+void AlternatingTree::shrink(NodeId x, NodeId y, NodeId root)
+{
+    // The same updates as EdmondsMatching::shrink, see there.
+    auto update_odd = [this, root](const std::vector<NodeId> &p) {
+        for (size_t i = 1; i < p.size(); i += 2)
+        {
+            NodeId n = p[i];
+            if (p[i - 1] == p.back() || n == p.back())
+            {
+                return;
+            }
+            if (rho(_phi[n]) != root)
+            {
+                _phi[_phi[n]] = n;
+            }
+        }
+    };
+    update_odd(_x_path);
+    update_odd(_y_path);
+
+    if (rho(x) != root)
+    {
+        _phi[x] = y;
+    }
+    if (rho(y) != root)
+    {
+        _phi[y] = x;
+    }
+
+    // The inner nodes on both paths are outer now, and all blossoms intersecting them are merged. The base keeps its
+    // level, which is the level of the whole blossom from now on.
+    for (const std::vector<NodeId> *p : {&_x_path, &_y_path})
+    {
+        for (auto n : *p)
+        {
+            if (n != p->back() && _label[n] == Label::inner)
+            {
+                _label[n] = Label::outer;
+                _queue.push_back(n);
+            }
+        }
+        for (auto n : *p)
+        {
+            _base[_blossoms.unite(n, root)] = root;
+        }
+    }
+}
+
+void AlternatingTree::augment(std::vector<NodeId> &mu, NodeId x, NodeId y)
+{
+    // The path from x to the root, alternately via mu and _phi. Its odd nodes take their _phi as mate.
+    _x_path.assign(1, x);
+    while (true)
+    {
+        NodeId cur = _x_path.back();
+        NodeId next = (_x_path.size() % 2 == 1) ? mu[cur] : _phi[cur];
+        if (next == cur)
+        {
+            break;
+        }
+        _x_path.push_back(next);
+    }
+    for (size_t i = 1; i < _x_path.size(); i += 2)
+    {
+        NodeId n = _x_path[i];
+        mu[_phi[n]] = n;
+        mu[n] = _phi[n];
+    }
+    mu[x] = y;
+    mu[y] = x;
+}
+
+} // namespace ED
@@ -0,0 +1,135 @@
+#ifndef ALTERNATING_TREE_HPP
+#define ALTERNATING_TREE_HPP
+
+#include "graph.hpp"
+#include "node_marker.hpp"
+#include "union_find.hpp"
+
+#include <limits>
+#include <vector>
+
+/**
+ * @file alternating_tree.hpp
+ *
+ * @brief This file provides the search for an augmenting path with a single alternating tree grown from one exposed
+ * node, as used by @c DynamicMatching and @c ApproximateMatching. Unlike @c EdmondsMatching, which grows a forest
+ * over the whole graph, it only touches the nodes of its tree.
+ */
+namespace ED
+{
+/**
+ * @class AlternatingTree
+ *
+ * @brief The state of a search with a single alternating tree, kept between searches so that every search only costs
+ * time proportional to the total degree of the nodes of its tree (times the inverse Ackermann function for the
+ * blossoms). Blossoms are shrunk as in @c EdmondsMatching.
+ */
+class AlternatingTree
+{
+  public:
+    //! A @c max_depth that does not limit the search.
+    static size_type constexpr unlimited_depth = std::numeric_limits<size_type>::max();
+
+    explicit AlternatingTree(NodeId num_nodes);
+
+    /**
+     * Grows an alternating tree in @c g (a @c Graph or a @c DynamicGraph) from the exposed node @c root and augments
+     * the matching @c mu along the first augmenting path found. Afterwards, only the nodes of the tree are reset.
+     * @param max_depth Only outer nodes reached by at most this many matching edges are scanned, where a blossom
+     * counts as its base. So only augmenting paths with at most 2 @c max_depth + 1 edges are found.
+     * @param blocked A node that is not added to the tree (e.g. the other end of a removed matching edge), or
+     * @c invalid_node_id. Neither are the nodes passed to @c ignore_tree.
+     * @return Whether an augmenting path was found.
+     */
+    template <typename G>
+    bool search(const G &g, std::vector<NodeId> &mu, NodeId root, size_type max_depth, NodeId blocked);
+
+    /**
+     * @return The nodes of the tree of the last search.
+     */
+    const std::vector<NodeId> &nodes() const;
+
+    /**
+     * @return Whether the last search skipped a grow step because of its @c max_depth.
+     */
+    bool truncated() const;
+
+    /**
+     * Leaves out the nodes of the tree of the last search in all later searches, e.g. if it is a Hungarian tree.
+     */
+    void ignore_tree();
+
+    /**
+     * @return Whether @c v was left out by @c ignore_tree.
+     */
+    bool ignored(NodeId v) const;
+
+  private:
+    enum class Label : unsigned char
+    {
+        none,
+        outer,
+        inner
+    };
+
+    /**
+     * @return The base of the blossom of the first node both tree paths from @c x and @c y pass, found by walking
+     * them alternately into @c _x_path and @c _y_path (which end at their first node in this blossom).
+     */
+    NodeId find_common_blossom(const std::vector<NodeId> &mu, NodeId x, NodeId y);
+
+    void shrink(NodeId x, NodeId y, NodeId root);
+
+    void augment(std::vector<NodeId> &mu, NodeId x, NodeId y);
+
+    //! Labels @c v and remembers it for the reset.
+    void add_to_tree(NodeId v, Label label);
+
+    NodeId rho(NodeId v);
+
+    //! The state of the current search, only valid at the nodes in @c _tree.
+    std::vector<Label> _label;
+    //! The number of matching edges on the tree path of an outer node to the root.
+    std::vector<size_type> _level;
+    std::vector<NodeId> _phi;
+    UnionFind _blossoms;
+    std::vector<NodeId> _base;
+    std::vector<NodeId> _tree;
+    //! The outer nodes to scan, in the order in which they became outer.
+    std::vector<NodeId> _queue;
+    bool _truncated;
+
+    std::vector<unsigned char> _ignored;
+
+    std::vector<NodeId> _x_path;
+    std::vector<NodeId> _y_path;
+    NodeMarker _x_marks;
+    NodeMarker _y_marks;
+};
+
+// BEGIN: Inline section
+
+inline const std::vector<NodeId> &AlternatingTree::nodes() const
+{
+    return _tree;
+}
+
+inline bool AlternatingTree::truncated() const
+{
+    return _truncated;
+}
+
+inline bool AlternatingTree::ignored(NodeId v) const
+{
+    return _ignored[v];
+}
+
+inline NodeId AlternatingTree::rho(NodeId v)
+{
+    return _base[_blossoms.find(v)];
+}
+
+// END: Inline section
+} // namespace ED
+
+#endif // ALTERNATING_TREE_HPP
@@ -0,0 +1,98 @@
+#include "approximate.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ED
+{
+size_type matching_edges_for(double epsilon)
+{
+    if (!(epsilon > 0 && epsilon <= 1))
+    {
+        throw std::runtime_error("The approximation epsilon has to be in (0, 1].");
+    }
+    // (k + 1) / (k + 2) >= 1 - epsilon if and only if k >= 1 / epsilon - 2. The tolerance keeps e.g. epsilon = 0.1
+    // from asking for one more edge because of rounding.
+    double const k = std::ceil(1 / epsilon - 2 - 1e-9);
+    if (k <= 0)
+    {
+        return 0;
+    }
+    // No path has more edges than there are nodes.
+    if (k >= double(invalid_node_id))
+    {
+        return invalid_node_id;
+    }
+    return size_type(k);
+}
+
+ApproximateMatching::ApproximateMatching(const Graph &g, size_type k, Initialization init)
+    : _g(g),
+      _k(k),
+      _mu(initial_matching(g, init)),
+      _size(matching_size(_mu)),
+      _tree(g.num_nodes()),
+      _removed_exposed(0)
+{
+    _stats.initial_size = _size;
+    std::vector<NodeId> exposed;
+    for (NodeId v = 0; v < g.num_nodes(); ++v)
+    {
+        if (_mu[v] == v)
+        {
+            exposed.push_back(v);
+        }
+    }
+
+    // A search that fails may succeed after other paths have been augmented, so the rounds go on until one finds
+    // nothing. Every round but the last one augments at least once.
+    while (exposed.size() > 1)
+    {
+        ++_stats.rounds;
+        size_type const augmentations = _stats.augmentations;
+        for (auto root : exposed)
+        {
+            // Without another exposed node there is nothing to search for.
+            if (_mu[root] == root && !_tree.ignored(root) && _g.num_nodes() - 2 * _size - _removed_exposed > 1)
+            {
+                search(root);
+            }
+        }
+        if (_stats.augmentations == augmentations)
+        {
+            break;
+        }
+        exposed.erase(std::remove_if(exposed.begin(),
+                                     exposed.end(),
+                                     [this](NodeId v) { return _mu[v] != v || _tree.ignored(v); }),
+                      exposed.end());
+    }
+}
+
+size_type ApproximateMatching::upper_bound() const
+{
+    // |M| (k + 2) / (k + 1) = |M| + |M| / (k + 1), without overflow for huge k.
+    return std::min<size_type>(_size + _size / (_k + 1), _g.num_nodes() / 2);
+}
+
+bool ApproximateMatching::search(NodeId root)
+{
+    ++_stats.searches;
+    bool const found = _tree.search(_g, _mu, root, _k, invalid_node_id);
+    _stats.tree_nodes += _tree.nodes().size();
+    if (found)
+    {
+        ++_size;
+        ++_stats.augmentations;
+    }
+    else if (!_tree.truncated())
+    {
+        _tree.ignore_tree();
+        ++_removed_exposed;
+        _stats.removed_nodes += _tree.nodes().size();
+    }
+    return found;
+}
+
+} // namespace ED
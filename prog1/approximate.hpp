@@ -0,0 +1,133 @@
+#ifndef APPROXIMATE_HPP
+#define APPROXIMATE_HPP
+
+#include "alternating_tree.hpp"
+#include "edmonds.hpp"
+#include "graph.hpp"
+#include "initial_matching.hpp"
+
+#include <vector>
+
+/**
+ * @file approximate.hpp
+ *
+ * @brief This file provides a matching that is maximum up to a factor of 1 - epsilon, for when a maximum matching
+ * takes too long. If a matching @c M has no augmenting path with at most 2k + 1 edges, then every matching has at most
+ * |M| (k + 2) / (k + 1) edges (Hopcroft and Karp: the symmetric difference with a maximum matching contains
+ * |M*| - |M| disjoint augmenting paths, each with at least k + 1 edges of @c M). So only augmenting paths up to that
+ * length are searched.
+ */
+namespace ED
+{
+/**
+ * What the search of an @c ApproximateMatching did.
+ */
+struct ApproximateStatistics
+{
+    size_type initial_size = 0;  //!< Number of edges of the initial matching.
+    size_type rounds = 0;        //!< Number of rounds over the exposed nodes.
+    size_type searches = 0;      //!< Number of alternating trees grown.
+    size_type augmentations = 0; //!< Number of augmenting paths found.
+    size_type tree_nodes = 0;    //!< Total number of nodes of all trees, i.e. the work done by the searches.
+    size_type removed_nodes = 0; //!< Number of nodes of Hungarian trees, which were ignored from then on.
+};
+
+/**
+ * @return The smallest k with (k + 1) / (k + 2) >= 1 - @c epsilon, i.e. the number of matching edges augmenting paths
+ * may have for a matching within a factor of 1 - @c epsilon of the maximum. Throws unless 0 < @c epsilon <= 1.
+ */
+size_type matching_edges_for(double epsilon);
+
+/**
+ * @class ApproximateMatching
+ *
+ * @brief Computes a matching of a @c Graph without augmenting paths of at most 2k + 1 edges: starting from an
+ * initial matching, every exposed node grows an alternating tree (see @c AlternatingTree), but only outer nodes
+ * reached by at most k matching edges are scanned, where a blossom counts as its base. This is repeated in rounds
+ * over all exposed nodes until a round finds no augmenting path. With k >= n / 2 the matching is maximum.
+ *
+ * A failed search that never had to stop at the depth limit has grown a Hungarian tree. Then a maximum matching of the
+ * graph without the nodes of the tree, together with the matching edges in the tree, is maximum (Edmonds), so the
+ * tree is removed for good and the guarantee carries over. Otherwise every round would search it again.
+ *
+ * A search costs time proportional to the total degree of the nodes of its tree, which is small for small k. The
+ * graph has to outlive this object.
+ */
+class ApproximateMatching
+{
+  public:
+    /**
+     * Computes the matching of @c g, starting from the one computed by @c init.
+     * @param k The number of matching edges augmenting paths may have, e.g. @c matching_edges_for(epsilon).
+     */
+    ApproximateMatching(const Graph &g, size_type k, Initialization init = Initialization::karp_sipser);
+
+    /**
+     * @return The matching as mate array (see initial_matching.hpp).
+     */
+    const std::vector<NodeId> &mates() const;
+
+    /**
+     * @return The number of edges of the matching.
+     */
+    size_type size() const;
+
+    /**
+     * @return The factor (k + 1) / (k + 2) by which the matching may be smaller than a maximum matching.
+     */
+    double guaranteed_ratio() const;
+
+    /**
+     * @return An upper bound on the size of a maximum matching: |M| (k + 2) / (k + 1), rounded down, and at most n / 2.
+     */
+    size_type upper_bound() const;
+
+    const ApproximateStatistics &statistics() const;
+
+  private:
+    /**
+     * Searches for an augmenting path with at most 2k + 1 edges from the exposed node @c root with
+     * @c AlternatingTree::search and augments the matching along it. If the tree is Hungarian, it is ignored from
+     * then on.
+     * @return Whether an augmenting path was found.
+     */
+    bool search(NodeId root);
+
+    const Graph &_g;
+    size_type _k;
+    std::vector<NodeId> _mu;
+    size_type _size;
+
+    //! Ignores the nodes of Hungarian trees. @c _removed_exposed is the number of exposed ones among them.
+    AlternatingTree _tree;
+    size_type _removed_exposed;
+
+    ApproximateStatistics _stats;
+};
+
+// BEGIN: Inline section
+
+inline const std::vector<NodeId> &ApproximateMatching::mates() const
+{
+    return _mu;
+}
+
+inline size_type ApproximateMatching::size() const
+{
+    return _size;
+}
+
+inline double ApproximateMatching::guaranteed_ratio() const
+{
+    return double(_k + 1) / double(_k + 2);
+}
+
+inline const ApproximateStatistics &ApproximateMatching::statistics() const
+{
+    return _stats;
+}
+
+// END: Inline section
+} // namespace ED
+
+#endif // APPROXIMATE_HPP
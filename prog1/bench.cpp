@@ -0,0 +1,979 @@
+/**
+   @file bench.cpp
+
+   @brief Small timing harness for the performance-relevant parts of this program.
+
+   Build in release mode (e.g. <tt>cmake -DCMAKE_BUILD_TYPE=Release</tt> and the @c bench.out target) and run
+   <tt>bench.out <mode> <graph files></tt> on e.g. all of @c graphs. Every measurement is the best of several repetitions.
+**/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <malloc.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "approximate.hpp"
+#include "binary_graph.hpp"
+#include "certificate.hpp"
+#include "components.hpp"
+#include "dynamic_matching.hpp"
+#include "dimacs_writer.hpp"
+#include "edmonds.hpp"
+#include "graph.hpp"
+#include "renumbering.hpp"
+
+namespace
+{
+int constexpr default_repetitions = 5;
+
+//! @return The best wall-clock time of @c repetitions calls of @c f in milliseconds.
+template <typename func>
+double best_time_ms(func f, int repetitions = default_repetitions)
+{
+    double best = 0;
+    for (int rep = 0; rep < repetitions; ++rep)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto stop = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+        if (rep == 0 || ms < best)
+        {
+            best = ms;
+        }
+    }
+    return best;
+}
+
+//! Compares the line-by-line stream loader, the memory-mapped loader and (if there is one) the binary cache.
+void bench_load(const std::vector<std::string> &files)
+{
+    std::cout << std::left << std::setw(24) << "instance" << std::right << std::setw(12) << "stream ms"
+              << std::setw(12) << "mmap ms" << std::setw(10) << "speedup" << std::setw(12) << "dmxb ms" << "\n";
+    for (const auto &file : files)
+    {
+        double stream_ms = best_time_ms([&file]() {
+            std::ifstream ifs(file);
+            ED::Graph g = ED::Graph::build_graph(ifs);
+        });
+        double mmap_ms = best_time_ms([&file]() { ED::Graph g = ED::Graph::parse_dimacs(file); });
+
+        std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::right
+                  << std::fixed << std::setprecision(2) << std::setw(12) << stream_ms << std::setw(12) << mmap_ms
+                  << std::setw(9) << stream_ms / mmap_ms << "x";
+
+        std::string cache = DIMACS::find_fresh_cache(file, DIMACS::BinaryKind::adjacency, sizeof(ED::NodeId));
+        if (cache.empty())
+        {
+            std::cout << std::setw(12) << "-" << "\n";
+            continue;
+        }
+        double binary_ms = best_time_ms([&cache]() { ED::Graph g = ED::Graph::load_binary(cache); });
+        std::cout << std::setw(12) << binary_ms << "\n";
+    }
+}
+
+//! @return The number of bytes currently allocated on the heap.
+std::size_t heap_in_use()
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+//! Reports the heap footprint of the loaded graph and the time to solve it.
+void bench_solve(const std::vector<std::string> &files)
+{
+    std::cout << std::left << std::setw(24) << "instance" << std::right << std::setw(12) << "graph KiB"
+              << std::setw(12) << "solve ms" << "\n";
+    for (const auto &file : files)
+    {
+        std::size_t before = heap_in_use();
+        ED::Graph g = ED::Graph::build_graph(file);
+        std::size_t footprint = heap_in_use() - before;
+
+        double solve_ms = best_time_ms([&g]() { ED::EdmondsMatching::get_matching(g); }, 3);
+
+        std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::right
+                  << std::fixed << std::setprecision(2) << std::setw(12) << footprint / 1024.0 << std::setw(12)
+                  << solve_ms << "\n";
+    }
+}
+
+//! Hardware events of the calling thread, or -1 where the event cannot be counted (e.g. in most virtual machines).
+struct EventCounts
+{
+    long long cache_references = -1;
+    long long cache_misses = -1;
+    long long instructions = -1;
+};
+
+//! @return The events counted with perf_event_open during a call of @c f.
+template <typename func>
+EventCounts count_events(func f)
+{
+    std::pair<std::uint64_t, long long EventCounts::*> const events[] = {
+        {PERF_COUNT_HW_CACHE_REFERENCES, &EventCounts::cache_references},
+        {PERF_COUNT_HW_CACHE_MISSES, &EventCounts::cache_misses},
+        {PERF_COUNT_HW_INSTRUCTIONS, &EventCounts::instructions}};
+    int fds[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = events[i].first;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fds[i] >= 0)
+        {
+            ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    f();
+    EventCounts counts;
+    for (int i = 0; i < 3; ++i)
+    {
+        long long value;
+        if (fds[i] >= 0)
+        {
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fds[i], &value, sizeof(value)) == sizeof(value))
+            {
+                counts.*events[i].second = value;
+            }
+            close(fds[i]);
+        }
+    }
+    return counts;
+}
+
+//! Solves every graph from the empty matching and reports the hardware events per scanned node, which show how often
+//! a scan misses the cache when it looks at the state of a neighbor, and the time per scan.
+void bench_counters(const std::vector<std::string> &files)
+{
+    std::cout << std::left << std::setw(24) << "instance" << std::right << std::setw(10) << "scans" << std::setw(12)
+              << "solve ms" << std::setw(10) << "ns/scan" << std::setw(12) << "refs/scan" << std::setw(12)
+              << "misses/scan" << std::setw(12) << "instr/scan" << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        ED::MatchingStatistics stats;
+        double solve_ms = best_time_ms(
+            [&g, &stats]() { ED::EdmondsMatching::get_mates(g, ED::MatchingOptions(), &stats); }, 3);
+        EventCounts counts = count_events([&g]() { ED::EdmondsMatching::get_mates(g); });
+
+        double const scans = std::max<double>(1, stats.scans);
+        auto per_scan = [scans](long long count) {
+            std::ostringstream out;
+            if (count < 0)
+            {
+                out << "n/a";
+            }
+            else
+            {
+                out << std::fixed << std::setprecision(1) << count / scans;
+            }
+            return out.str();
+        };
+        std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::right
+                  << std::setw(10) << stats.scans << std::fixed << std::setprecision(2) << std::setw(12) << solve_ms
+                  << std::setprecision(1) << std::setw(10) << 1e6 * solve_ms / scans << std::setw(12)
+                  << per_scan(counts.cache_references) << std::setw(12) << per_scan(counts.cache_misses)
+                  << std::setw(12) << per_scan(counts.instructions) << "\n";
+    }
+}
+
+//! Reports how many nodes the search scans and resets (starting from the empty matching) and the time per scanned node.
+void bench_scan(const std::vector<std::string> &files)
+{
+    std::cout << std::left << std::setw(24) << "instance" << std::right << std::setw(10) << "scans" << std::setw(10)
+              << "shrinks" << std::setw(10) << "augments" << std::setw(12) << "reset" << std::setw(12) << "solve ms"
+              << std::setw(12) << "ns/scan" << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        ED::MatchingStatistics stats;
+        double solve_ms = best_time_ms(
+            [&g, &stats]() { ED::EdmondsMatching::get_matching(g, ED::MatchingOptions(), &stats); });
+
+        std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::right
+                  << std::setw(10) << stats.scans << std::setw(10) << stats.shrinks << std::setw(10)
+                  << stats.augmentations << std::setw(12) << stats.reset_nodes << std::fixed << std::setprecision(2) << std::setw(12) << solve_ms
+                  << std::setprecision(1) << std::setw(12)
+                  << (stats.scans == 0 ? 0.0 : 1e6 * solve_ms / stats.scans) << "\n";
+    }
+}
+
+//! Compares the engines, starting from the empty matching and from Karp-Sipser.
+void bench_engines(const std::vector<std::string> &files)
+{
+    std::vector<std::pair<std::string, ED::Engine>> const engines = {{"edmonds", ED::Engine::edmonds},
+                                                                     {"phases", ED::Engine::phases}};
+    std::vector<std::pair<std::string, ED::Initialization>> const inits = {
+        {"empty", ED::Initialization::empty}, {"karp-sipser", ED::Initialization::karp_sipser}};
+
+    std::cout << std::left << std::setw(24) << "instance" << std::setw(14) << "init" << std::setw(10) << "engine"
+              << std::right << std::setw(10) << "size" << std::setw(10) << "phases" << std::setw(12) << "solve ms"
+              << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        for (const auto &init : inits)
+        {
+            for (const auto &engine : engines)
+            {
+                ED::MatchingOptions options;
+                options.initialization = init.second;
+                options.engine = engine.second;
+                ED::MatchingStatistics stats;
+                double solve_ms = best_time_ms(
+                    [&g, &options, &stats]() { ED::EdmondsMatching::get_matching(g, options, &stats); }, 3);
+
+                std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::setw(14)
+                          << init.first << std::setw(10) << engine.first << std::right << std::setw(10)
+                          << stats.final_size << std::setw(10) << stats.phases << std::fixed << std::setprecision(2)
+                          << std::setw(12) << solve_ms << "\n";
+            }
+        }
+    }
+}
+
+//! Compares the approximate matching for several epsilon with the exact solver (both from the Karp-Sipser matching):
+//! time, size, the achieved fraction of the maximum and the guaranteed one.
+void bench_approximate(const std::vector<std::string> &files)
+{
+    std::vector<double> const epsilons = {0.5, 0.25, 0.1, 0.01};
+
+    std::cout << std::left << std::setw(24) << "instance" << std::setw(10) << "epsilon" << std::right << std::setw(8)
+              << "size" << std::setw(10) << "achieved" << std::setw(12) << "guaranteed" << std::setw(10) << "rounds"
+              << std::setw(12) << "solve ms" << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        std::string const name = file.substr(file.find_last_of('/') + 1);
+        ED::MatchingOptions options;
+        options.initialization = ED::Initialization::karp_sipser;
+        ED::MatchingStatistics stats;
+        double exact_ms = best_time_ms(
+            [&g, &options, &stats]() { ED::EdmondsMatching::get_mates(g, options, &stats); }, 3);
+        ED::size_type const maximum = stats.final_size;
+        std::cout << std::left << std::setw(24) << name << std::setw(10) << "exact" << std::right << std::setw(8)
+                  << maximum << std::fixed << std::setprecision(4) << std::setw(10) << 1.0 << std::setw(12) << 1.0
+                  << std::setw(10) << "-" << std::setprecision(2) << std::setw(12) << exact_ms << "\n";
+
+        for (auto epsilon : epsilons)
+        {
+            ED::size_type const k = ED::matching_edges_for(epsilon);
+            ED::size_type size = 0;
+            double ratio = 0;
+            ED::size_type rounds = 0;
+            double approximate_ms = best_time_ms(
+                [&g, k, &size, &ratio, &rounds]() {
+                    ED::ApproximateMatching approximate(g, k);
+                    size = approximate.size();
+                    ratio = approximate.guaranteed_ratio();
+                    rounds = approximate.statistics().rounds;
+                },
+                3);
+            std::cout << std::left << std::setw(24) << name << std::fixed << std::setprecision(2) << std::setw(10)
+                      << epsilon << std::right << std::setw(8) << size << std::setprecision(4) << std::setw(10)
+                      << (maximum > 0 ? double(size) / maximum : 1.0) << std::setw(12) << ratio << std::setw(10)
+                      << rounds << std::setprecision(2) << std::setw(12) << approximate_ms << "\n";
+        }
+    }
+}
+
+//! Reports the parts of @c matching_upper_bound, the time to compute it, and the scans and solve time (from the
+//! Karp-Sipser matching) with and without stopping at the bound.
+void bench_bounds(const std::vector<std::string> &files)
+{
+    std::cout << std::left << std::setw(24) << "instance" << std::right << std::setw(8) << "n / 2" << std::setw(8)
+              << "odd" << std::setw(8) << "cover" << std::setw(8) << "bound" << std::setw(8) << "maximum"
+              << std::setw(10) << "bound ms" << std::setw(10) << "scans" << std::setw(10) << "no stop" << std::setw(10)
+              << "solve ms" << std::setw(10) << "no stop" << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        ED::MatchingBound bound;
+        double bound_ms = best_time_ms([&g, &bound]() { bound = ED::matching_upper_bound(g); });
+
+        ED::MatchingOptions options;
+        options.initialization = ED::Initialization::karp_sipser;
+        ED::MatchingStatistics with_stop;
+        double stop_ms = best_time_ms(
+            [&g, &options, &with_stop]() { ED::EdmondsMatching::get_mates(g, options, &with_stop); }, 3);
+        options.upper_bound = false;
+        ED::MatchingStatistics without_stop;
+        double full_ms = best_time_ms(
+            [&g, &options, &without_stop]() { ED::EdmondsMatching::get_mates(g, options, &without_stop); }, 3);
+
+        std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::right
+                  << std::setw(8) << g.num_nodes() / 2 << std::setw(8) << (g.num_nodes() - bound.odd_components) / 2
+                  << std::setw(8) << bound.cover << std::setw(8) << bound.value << std::setw(8)
+                  << with_stop.final_size << std::fixed << std::setprecision(2) << std::setw(10) << bound_ms
+                  << std::setw(10) << with_stop.scans << std::setw(10) << without_stop.scans << std::setw(10)
+                  << stop_ms << std::setw(10) << full_ms << "\n";
+    }
+}
+
+//! Compares the node orders: the time to renumber the graph, the mean id distance of the endpoints of an edge, and the
+//! scans, solve time (from the empty matching) and time per scan on the renumbered graph.
+void bench_order(const std::vector<std::string> &files)
+{
+    std::vector<std::pair<std::string, DIMACS::NodeOrder>> const orders = {{"none", DIMACS::NodeOrder::none},
+                                                                           {"bfs", DIMACS::NodeOrder::bfs},
+                                                                           {"rcm", DIMACS::NodeOrder::rcm},
+                                                                           {"degree", DIMACS::NodeOrder::degree}};
+
+    std::cout << std::left << std::setw(24) << "instance" << std::setw(8) << "order" << std::right << std::setw(12)
+              << "renumber ms" << std::setw(12) << "mean gap" << std::setw(10) << "scans" << std::setw(12)
+              << "solve ms" << std::setw(10) << "ns/scan" << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        for (const auto &order : orders)
+        {
+            std::unique_ptr<ED::NodeRenumbering> renumbering;
+            double renumber_ms = best_time_ms(
+                [&g, &order, &renumbering]() { renumbering.reset(new ED::NodeRenumbering(g, order.second)); }, 3);
+            const ED::Graph &renumbered = renumbering->graph();
+
+            double gap = 0;
+            for (ED::NodeId v = 0; v < renumbered.num_nodes(); ++v)
+            {
+                for (auto w : renumbered.node(v).neighbors())
+                {
+                    gap += v < w ? w - v : v - w;
+                }
+            }
+            gap /= std::max<double>(1, 2.0 * renumbered.num_edges());
+
+            ED::MatchingStatistics stats;
+            double solve_ms = best_time_ms([&renumbered, &stats]() {
+                ED::EdmondsMatching::get_mates(renumbered, ED::MatchingOptions(), &stats);
+            });
+
+            std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::setw(8)
+                      << order.first << std::right << std::fixed << std::setprecision(2) << std::setw(12)
+                      << renumber_ms << std::setprecision(0) << std::setw(12) << gap << std::setw(10) << stats.scans
+                      << std::setprecision(2) << std::setw(12) << solve_ms << std::setprecision(1) << std::setw(10)
+                      << (stats.scans == 0 ? 0.0 : 1e6 * solve_ms / stats.scans) << "\n";
+        }
+    }
+}
+
+//! Compares adjacency lists and bitsets in the search, from the empty and from the Karp-Sipser matching, and reports
+//! the density and which one the automatic choice takes.
+void bench_adjacency(const std::vector<std::string> &files)
+{
+    std::vector<std::pair<std::string, ED::Initialization>> const inits = {
+        {"empty", ED::Initialization::empty}, {"karp-sipser", ED::Initialization::karp_sipser}};
+
+    std::cout << std::left << std::setw(24) << "instance" << std::right << std::setw(10) << "density" << std::setw(8)
+              << "auto" << std::left << "  " << std::setw(14) << "init" << std::right << std::setw(12) << "lists ms"
+              << std::setw(12) << "bitsets ms" << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        double const n = g.num_nodes();
+        double const density = n > 1 ? 2.0 * g.num_edges() / (n * (n - 1)) : 0;
+        for (const auto &init : inits)
+        {
+            ED::MatchingOptions options;
+            options.initialization = init.second;
+            ED::MatchingStatistics stats;
+            options.adjacency = ED::Adjacency::automatic;
+            ED::EdmondsMatching::get_matching(g, options, &stats);
+            options.adjacency = ED::Adjacency::lists;
+            double lists_ms = best_time_ms([&g, &options]() { ED::EdmondsMatching::get_matching(g, options); }, 3);
+            options.adjacency = ED::Adjacency::bitsets;
+            double bitsets_ms = best_time_ms([&g, &options]() { ED::EdmondsMatching::get_matching(g, options); }, 3);
+
+            std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::right
+                      << std::fixed << std::setprecision(4) << std::setw(10) << density << std::setw(8)
+                      << (stats.bitsets ? "bitsets" : "lists") << std::left << "  " << std::setw(14)
+                      << init.first << std::right << std::setprecision(2) << std::setw(12) << lists_ms
+                      << std::setw(12) << bitsets_ms << "\n";
+        }
+    }
+}
+
+//! Reports the time of the bipartiteness test and the solve time (from the empty matching) with and without the
+//! Hopcroft-Karp fast path, for both engines.
+void bench_bipartite(const std::vector<std::string> &files)
+{
+    std::cout << std::left << std::setw(24) << "instance" << std::setw(11) << "bipartite" << std::right
+              << std::setw(12) << "color ms" << std::setw(12) << "hk ms" << std::setw(12) << "edmonds ms"
+              << std::setw(12) << "phases ms" << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        std::vector<unsigned char> side;
+        bool bipartite = false;
+        double color_ms = best_time_ms([&g, &side, &bipartite]() { bipartite = ED::two_coloring(g, side); });
+
+        ED::MatchingOptions options;
+        options.bipartite_fast_path = true;
+        double fast_ms = best_time_ms([&g, &options]() { ED::EdmondsMatching::get_matching(g, options); }, 3);
+        options.bipartite_fast_path = false;
+        double edmonds_ms = best_time_ms([&g, &options]() { ED::EdmondsMatching::get_matching(g, options); }, 3);
+        options.engine = ED::Engine::phases;
+        double phases_ms = best_time_ms([&g, &options]() { ED::EdmondsMatching::get_matching(g, options); }, 3);
+
+        std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::setw(11)
+                  << (bipartite ? "yes" : "no") << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << color_ms << std::setprecision(2) << std::setw(12)
+                  << (bipartite ? fast_ms : edmonds_ms) << std::setw(12) << edmonds_ms << std::setw(12) << phases_ms
+                  << "\n";
+    }
+}
+
+//! Reports how much each reduction removes, the time of the reductions and the solve time with and without them.
+void bench_kernel(const std::vector<std::string> &files)
+{
+    std::cout << std::left << std::setw(24) << "instance" << std::right << std::setw(8) << "nodes" << std::setw(10)
+              << "isolated" << std::setw(8) << "deg 1" << std::setw(8) << "deg 2" << std::setw(8) << "kernel"
+              << std::setw(12) << "reduce ms" << std::setw(12) << "solve ms" << std::setw(12) << "kernel ms" << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        ED::ReductionStatistics reductions;
+        double reduce_ms = best_time_ms([&g, &reductions]() { reductions = ED::Kernelization(g).statistics(); });
+
+        ED::MatchingOptions options;
+        options.initialization = ED::Initialization::karp_sipser;
+        double solve_ms = best_time_ms([&g, &options]() { ED::EdmondsMatching::get_matching(g, options); }, 3);
+        options.kernelize = true;
+        double kernel_ms = best_time_ms([&g, &options]() { ED::EdmondsMatching::get_matching(g, options); }, 3);
+
+        std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::right
+                  << std::setw(8) << g.num_nodes() << std::setw(10) << reductions.isolated << std::setw(8)
+                  << reductions.degree_one << std::setw(8) << reductions.degree_two << std::setw(8)
+                  << reductions.kernel_nodes << std::fixed << std::setprecision(2) << std::setw(12) << reduce_ms
+                  << std::setw(12) << solve_ms << std::setw(12) << kernel_ms << "\n";
+    }
+}
+
+//! Applies a random stream of edge deletions and insertions to a @c DynamicMatching and compares the time per update
+//! to solving the final graph from scratch. After every batch of updates, the matching has to be a matching of the
+//! current graph and as large as the one @c EdmondsMatching::get_matching finds.
+void bench_dynamic(const std::vector<std::string> &files)
+{
+    int constexpr num_updates = 2000;
+    int constexpr batch_size = 100;
+    std::cout << std::left << std::setw(24) << "instance" << std::right << std::setw(10) << "updates" << std::setw(10)
+              << "searches" << std::setw(14) << "tree nodes" << std::setw(14) << "update us" << std::setw(12)
+              << "solve ms" << std::setw(10) << "speedup" << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        if (g.num_nodes() < 2)
+        {
+            continue;
+        }
+        ED::MatchingOptions options;
+        options.initialization = ED::Initialization::karp_sipser;
+        ED::DynamicMatching matching(g, options);
+
+        // Every other update deletes a random edge (at a random node with neighbors), the others insert a random one.
+        std::mt19937_64 random(42);
+        std::uniform_int_distribution<ED::NodeId> random_node(0, g.num_nodes() - 1);
+        struct Update
+        {
+            bool insert;
+            ED::NodeId a;
+            ED::NodeId b;
+        };
+        std::vector<Update> updates;
+        ED::DynamicGraph shadow(g);
+        for (int i = 0; i < num_updates; ++i)
+        {
+            ED::NodeId a = random_node(random);
+            if (i % 2 == 0 && shadow.num_edges() > 0)
+            {
+                while (shadow.node(a).degree() == 0)
+                {
+                    a = random_node(random);
+                }
+                ED::NodeIdRange neighbors = shadow.node(a).neighbors();
+                ED::NodeId b = neighbors[random() % neighbors.size()];
+                shadow.remove_edge(a, b);
+                updates.push_back(Update{false, a, b});
+            }
+            else
+            {
+                ED::NodeId b = random_node(random);
+                while (b == a)
+                {
+                    b = random_node(random);
+                }
+                shadow.add_edge(a, b);
+                updates.push_back(Update{true, a, b});
+            }
+        }
+
+        // The updates are applied in batches. After every batch, the matching is checked against a solve from scratch
+        // (outside of the timing), so a wrong repair is reported at the batch that caused it.
+        double update_time_us = 0;
+        for (int first = 0; first < num_updates; first += batch_size)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = first; i < std::min(first + batch_size, num_updates); ++i)
+            {
+                if (updates[i].insert)
+                {
+                    matching.insert_edge(updates[i].a, updates[i].b);
+                }
+                else
+                {
+                    matching.delete_edge(updates[i].a, updates[i].b);
+                }
+            }
+            update_time_us +=
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+            const ED::DynamicGraph &current = matching.graph();
+            bool valid = true;
+            for (ED::NodeId v = 0; v < current.num_nodes() && valid; ++v)
+            {
+                ED::NodeId w = matching.mate(v);
+                valid = matching.mate(w) == v && (w == v || current.has_edge(v, w));
+            }
+            ED::MatchingStatistics batch_stats;
+            ED::EdmondsMatching::get_matching(current.to_graph(), options, &batch_stats);
+            if (!valid || batch_stats.final_size != matching.size())
+            {
+                std::cerr << "Dynamic matching after update " << std::min(first + batch_size, num_updates) << " of "
+                          << file << " is " << (valid ? "" : "not a matching, ") << "of size " << matching.size()
+                          << " instead of " << batch_stats.final_size << "." << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
+        }
+        double update_us = update_time_us / updates.size();
+
+        ED::Graph final_graph = shadow.to_graph();
+        double solve_ms = best_time_ms(
+            [&final_graph, &options]() { ED::EdmondsMatching::get_matching(final_graph, options); }, 3);
+
+        std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::right
+                  << std::setw(10) << updates.size() << std::setw(10) << matching.statistics().searches
+                  << std::setw(14) << matching.statistics().tree_nodes << std::fixed << std::setprecision(2)
+                  << std::setw(14) << update_us << std::setw(12) << solve_ms << std::setprecision(0) << std::setw(9)
+                  << 1000 * solve_ms / update_us << "x\n";
+    }
+}
+
+//! Solves every graph, changes it slightly (2% of the edges dropped, n / 100 random edges added) and compares solving
+//! the changed graph from scratch with starting from the old matching.
+void bench_warm(const std::vector<std::string> &files)
+{
+    std::cout << std::left << std::setw(24) << "instance" << std::right << std::setw(10) << "dropped" << std::setw(10)
+              << "initial" << std::setw(10) << "warm" << std::setw(10) << "final" << std::setw(12) << "cold ms"
+              << std::setw(12) << "warm ms" << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        ED::MatchingOptions options;
+        options.initialization = ED::Initialization::karp_sipser;
+        ED::Graph old_matching = ED::EdmondsMatching::get_matching(g, options);
+
+        std::mt19937_64 random(42);
+        ED::GraphBuilder builder(g.num_nodes(), g.num_edges());
+        for (ED::NodeId v = 0; v < g.num_nodes(); ++v)
+        {
+            for (auto w : g.node(v).neighbors())
+            {
+                if (v < w && random() % 50 != 0)
+                {
+                    builder.add_edge(v, w);
+                }
+            }
+        }
+        for (ED::NodeId i = 0; g.num_nodes() > 1 && i < g.num_nodes() / 100; ++i)
+        {
+            ED::NodeId a = random() % g.num_nodes();
+            ED::NodeId b = random() % g.num_nodes();
+            if (a != b)
+            {
+                builder.add_edge(a, b);
+            }
+        }
+        ED::Graph changed = builder.build();
+
+        ED::MatchingStatistics cold_stats;
+        double cold_ms = best_time_ms(
+            [&changed, &options, &cold_stats]() { ED::EdmondsMatching::get_matching(changed, options, &cold_stats); });
+        options.warm_start = &old_matching;
+        ED::MatchingStatistics warm_stats;
+        double warm_ms = best_time_ms(
+            [&changed, &options, &warm_stats]() { ED::EdmondsMatching::get_matching(changed, options, &warm_stats); });
+
+        std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::right
+                  << std::setw(10) << warm_stats.warm_start_dropped << std::setw(10) << cold_stats.initial_size
+                  << std::setw(10) << warm_stats.initial_size << std::setw(10) << warm_stats.final_size << std::fixed
+                  << std::setprecision(2) << std::setw(12) << cold_ms << std::setw(12) << warm_ms << "\n";
+    }
+}
+
+//! Compares solving every graph with computing the Tutte–Berge set of the result and checking the certificate.
+void bench_certificate(const std::vector<std::string> &files)
+{
+    std::cout << std::left << std::setw(24) << "instance" << std::right << std::setw(10) << "set size" << std::setw(12)
+              << "solve ms" << std::setw(12) << "certify ms" << std::setw(12) << "check ms" << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        ED::MatchingOptions options;
+        options.initialization = ED::Initialization::karp_sipser;
+        std::vector<ED::NodeId> mates;
+        double solve_ms = best_time_ms([&g, &options, &mates]() { mates = ED::EdmondsMatching::get_mates(g, options); });
+        std::vector<ED::NodeId> set;
+        double certify_ms = best_time_ms([&g, &mates, &set]() { set = ED::EdmondsMatching::tutte_berge_set(g, mates); });
+        ED::Graph matching = ED::matching_graph(mates);
+        ED::CertificateCheck check;
+        double check_ms =
+            best_time_ms([&g, &matching, &set, &check]() { check = ED::check_certificate(g, matching, set); });
+        if (!check.valid)
+        {
+            std::cerr << "Certificate of " << file << " rejected: " << check.error << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+
+        std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::right
+                  << std::setw(10) << set.size() << std::fixed << std::setprecision(2) << std::setw(12) << solve_ms
+                  << std::setw(12) << certify_ms << std::setw(12) << check_ms << "\n";
+    }
+}
+
+//! @return 1, 2, 4, ... up to the number of hardware threads, which is included, and at least up to @c minimum.
+std::vector<unsigned> thread_counts(unsigned minimum)
+{
+    std::vector<unsigned> counts;
+    unsigned const hardware = std::max(std::thread::hardware_concurrency(), minimum);
+    for (unsigned count = 1; count < hardware; count *= 2)
+    {
+        counts.push_back(count);
+    }
+    counts.push_back(hardware == 0 ? 1 : hardware);
+    return counts;
+}
+
+//! Solves every file with 1, 2, 4, ... threads (at least 2, so that the components are split off even on a single
+//! hardware thread).
+void bench_components(const std::vector<std::string> &files)
+{
+    std::vector<unsigned> const counts = thread_counts(2);
+
+    std::cout << std::left << std::setw(24) << "instance" << std::right << std::setw(12) << "components";
+    for (auto count : counts)
+    {
+        std::cout << std::setw(10) << count << "T ms";
+    }
+    std::cout << "\n";
+
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::right
+                  << std::setw(12) << ED::ComponentSplit(g, 1).num_components() << std::fixed << std::setprecision(2);
+        for (auto count : counts)
+        {
+            ED::MatchingOptions options;
+            options.initialization = ED::Initialization::karp_sipser;
+            options.num_threads = count;
+            double ms = best_time_ms([&g, &options]() { ED::EdmondsMatching::get_matching(g, options); }, 3);
+            std::cout << std::setw(14) << ms;
+        }
+        std::cout << "\n";
+    }
+}
+
+//! Parses every file with 1, 2, 4, ... threads up to the number of hardware threads.
+void bench_threads(const std::vector<std::string> &files)
+{
+    std::vector<unsigned> const counts = thread_counts(1);
+
+    std::cout << std::left << std::setw(24) << "instance" << std::right;
+    for (auto count : counts)
+    {
+        std::cout << std::setw(10) << count << "T ms";
+    }
+    std::cout << "\n";
+
+    for (const auto &file : files)
+    {
+        std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::right
+                  << std::fixed << std::setprecision(2);
+        for (auto count : counts)
+        {
+            double ms = best_time_ms([&file, count]() { ED::Graph g = ED::Graph::parse_dimacs(file, count); });
+            std::cout << std::setw(14) << ms;
+        }
+        std::cout << "\n";
+    }
+}
+
+//! Compares writing every graph with operator<< to the buffered and the mapped @c DIMACS::Writer.
+void bench_write(const std::vector<std::string> &files)
+{
+    std::string const target = "/tmp/bench_write.dmx";
+    std::cout << std::left << std::setw(24) << "instance" << std::right << std::setw(12) << "stream ms"
+              << std::setw(12) << "write ms" << std::setw(12) << "mmap ms" << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        double stream_ms = best_time_ms([&g, &target]() {
+            std::ofstream ofs(target);
+            ofs << g;
+        });
+        double write_ms = best_time_ms([&g, &target]() {
+            DIMACS::Writer out(target, DIMACS::Writer::Mode::buffered);
+            g.write_dimacs(out);
+            out.close();
+        });
+        double mmap_ms = best_time_ms([&g, &target]() {
+            DIMACS::Writer out(target, DIMACS::Writer::Mode::mapped);
+            g.write_dimacs(out);
+            out.close();
+        });
+
+        std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::right
+                  << std::fixed << std::setprecision(2) << std::setw(12) << stream_ms << std::setw(12) << write_ms
+                  << std::setw(12) << mmap_ms << "\n";
+    }
+    std::remove(target.c_str());
+}
+
+//! Interrupts every engine at its first look at the clock, writing a checkpoint, and resumes it with every engine. A
+//! resume with the same engine has to reach the maximum, one with another engine has to be refused.
+void bench_checkpoint(const std::vector<std::string> &files)
+{
+    std::string const target = "/tmp/bench_checkpoint.dmxb";
+    std::vector<std::pair<std::string, ED::Engine>> const engines = {{"edmonds", ED::Engine::edmonds},
+                                                                     {"phases", ED::Engine::phases}};
+
+    std::cout << std::left << std::setw(24) << "instance" << std::setw(10) << "written" << std::setw(10) << "resumed"
+              << std::right << std::setw(12) << "at stop" << std::setw(10) << "final" << std::setw(10) << "maximum"
+              << std::setw(12) << "resume ms" << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        ED::MatchingOptions options;
+        options.initialization = ED::Initialization::empty;
+        ED::MatchingStatistics max_stats;
+        ED::EdmondsMatching::get_matching(g, options, &max_stats);
+
+        for (const auto &writer : engines)
+        {
+            options.engine = writer.second;
+            options.checkpoint = target;
+            options.deadline = std::chrono::steady_clock::now();
+            ED::MatchingStatistics stop_stats;
+            ED::EdmondsMatching::get_matching(g, options, &stop_stats);
+            options.checkpoint.clear();
+            options.deadline = std::chrono::steady_clock::time_point::max();
+            if (stop_stats.checkpoints == 0)
+            {
+                // Solved before the first look at the clock.
+                continue;
+            }
+
+            for (const auto &reader : engines)
+            {
+                options.engine = reader.second;
+                options.resume = target;
+                ED::MatchingStatistics stats;
+                bool refused = false;
+                auto start = std::chrono::steady_clock::now();
+                try
+                {
+                    ED::EdmondsMatching::get_matching(g, options, &stats);
+                }
+                catch (const std::runtime_error &)
+                {
+                    refused = true;
+                }
+                double resume_ms =
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                options.resume.clear();
+
+                std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::setw(10)
+                          << writer.first << std::setw(10) << reader.first << std::right << std::setw(12)
+                          << stop_stats.final_size << std::setw(10);
+                if (refused)
+                {
+                    std::cout << "refused";
+                }
+                else
+                {
+                    std::cout << stats.final_size;
+                }
+                std::cout << std::setw(10) << max_stats.final_size << std::fixed << std::setprecision(2)
+                          << std::setw(12) << resume_ms << "\n";
+
+                bool const same_engine = writer.second == reader.second;
+                if (refused == same_engine || (same_engine && stats.final_size != max_stats.final_size))
+                {
+                    std::cerr << "Resuming the " << writer.first << " checkpoint of " << file << " with "
+                              << reader.first << " "
+                              << (refused ? "was refused."
+                                          : same_engine ? "did not find the maximum." : "was not refused.")
+                              << std::endl;
+                    std::exit(EXIT_FAILURE);
+                }
+            }
+        }
+    }
+    std::remove(target.c_str());
+}
+
+//! Reports how much of the maximum matching every initialization finds, and the total solve time with it.
+void bench_init(const std::vector<std::string> &files)
+{
+    std::vector<std::pair<std::string, ED::Initialization>> const inits = {
+        {"empty", ED::Initialization::empty},
+        {"greedy", ED::Initialization::greedy},
+        {"min-degree", ED::Initialization::min_degree},
+        {"karp-sipser", ED::Initialization::karp_sipser}};
+
+    std::cout << std::left << std::setw(24) << "instance" << std::setw(14) << "init" << std::right << std::setw(10)
+              << "initial" << std::setw(10) << "final" << std::setw(10) << "share" << std::setw(12) << "solve ms"
+              << "\n";
+    for (const auto &file : files)
+    {
+        ED::Graph g = ED::Graph::build_graph(file);
+        for (const auto &init : inits)
+        {
+            ED::MatchingOptions options;
+            options.initialization = init.second;
+            ED::MatchingStatistics stats;
+            double solve_ms =
+                best_time_ms([&g, &options, &stats]() { ED::EdmondsMatching::get_matching(g, options, &stats); }, 3);
+
+            std::cout << std::left << std::setw(24) << file.substr(file.find_last_of('/') + 1) << std::setw(14)
+                      << init.first << std::right << std::setw(10) << stats.initial_size << std::setw(10)
+                      << stats.final_size << std::fixed << std::setprecision(1) << std::setw(9)
+                      << (stats.final_size == 0 ? 100.0 : 100.0 * stats.initial_size / stats.final_size) << "%"
+                      << std::setprecision(2) << std::setw(12) << solve_ms << std::setprecision(1) << std::setw(10)
+                      << (stats.scans == 0 ? 0.0 : 1e6 * solve_ms / stats.scans) << "\n";
+        }
+    }
+}
+}   // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "Program call: <program_name> (load|solve|scan|counters|engines|bounds|order|approximate|adjacency|bipartite|components|kernel|dynamic|warm|certificate|checkpoint|threads|write|init) <input_graph>..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string mode = argv[1];
+    std::vector<std::string> files(argv + 2, argv + argc);
+
+    if (mode == "load")
+    {
+        bench_load(files);
+    }
+    else if (mode == "threads")
+    {
+        bench_threads(files);
+    }
+    else if (mode == "write")
+    {
+        bench_write(files);
+    }
+    else if (mode == "init")
+    {
+        bench_init(files);
+    }
+    else if (mode == "solve")
+    {
+        bench_solve(files);
+    }
+    else if (mode == "scan")
+    {
+        bench_scan(files);
+    }
+    else if (mode == "counters")
+    {
+        bench_counters(files);
+    }
+    else if (mode == "engines")
+    {
+        bench_engines(files);
+    }
+    else if (mode == "bounds")
+    {
+        bench_bounds(files);
+    }
+    else if (mode == "order")
+    {
+        bench_order(files);
+    }
+    else if (mode == "approximate")
+    {
+        bench_approximate(files);
+    }
+    else if (mode == "adjacency")
+    {
+        bench_adjacency(files);
+    }
+    else if (mode == "bipartite")
+    {
+        bench_bipartite(files);
+    }
+    else if (mode == "components")
+    {
+        bench_components(files);
+    }
+    else if (mode == "kernel")
+    {
+        bench_kernel(files);
+    }
+    else if (mode == "dynamic")
+    {
+        bench_dynamic(files);
+    }
+    else if (mode == "warm")
+    {
+        bench_warm(files);
+    }
+    else if (mode == "certificate")
+    {
+        bench_certificate(files);
+    }
+    else if (mode == "checkpoint")
+    {
+        bench_checkpoint(files);
+    }
+    else
+    {
+        std::cerr << "Unknown benchmark mode " << mode << "." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+#include "bipartite.hpp"
+
+#include <limits>
+
+namespace ED
+{
+namespace
+{
+unsigned char constexpr no_side = 2;
+size_type constexpr unreached = std::numeric_limits<size_type>::max();
+} // namespace
+
+bool two_coloring(const Graph &g, std::vector<unsigned char> &side)
+{
+    side.assign(g.num_nodes(), no_side);
+    std::vector<NodeId> queue;
+    queue.reserve(g.num_nodes());
+    for (NodeId start = 0; start < g.num_nodes(); ++start)
+    {
+        if (side[start] != no_side)
+        {
+            continue;
+        }
+        side[start] = 0;
+        queue.push_back(start);
+        for (size_t i = queue.size() - 1; i < queue.size(); ++i)
+        {
+            NodeId v = queue[i];
+            for (auto w : g.node(v).neighbors())
+            {
+                if (side[w] == no_side)
+                {
+                    side[w] = side[v] ^ 1;
+                    queue.push_back(w);
+                }
+                else if (side[w] == side[v])
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+size_type hopcroft_karp(const Graph &g, const std::vector<unsigned char> &side, std::vector<NodeId> &mate)
+{
+    // Only nodes of color 0 get a distance: the number of matching edges on a shortest alternating path to them
+    // from an exposed node of color 0.
+    std::vector<size_type> dist(g.num_nodes());
+    std::vector<NodeId> queue;
+    queue.reserve(g.num_nodes());
+    // Position of the next neighbor to try for every node in the depth-first search.
+    std::vector<size_type> next(g.num_nodes());
+    std::vector<NodeId> stack;
+
+    size_type phases = 0;
+    while (true)
+    {
+        queue.clear();
+        for (NodeId v = 0; v < g.num_nodes(); ++v)
+        {
+            dist[v] = unreached;
+            if (side[v] == 0 && mate[v] == v)
+            {
+                dist[v] = 0;
+                queue.push_back(v);
+            }
+        }
+        size_t const num_roots = queue.size();
+
+        // Breadth-first search up to the first layer that has an exposed neighbor of color 1.
+        size_type limit = unreached;
+        for (size_t i = 0; i < queue.size(); ++i)
+        {
+            NodeId u = queue[i];
+            if (dist[u] >= limit)
+            {
+                break;
+            }
+            for (auto v : g.node(u).neighbors())
+            {
+                NodeId w = mate[v];
+                if (w == v)
+                {
+                    limit = dist[u];
+                }
+                else if (dist[w] == unreached)
+                {
+                    dist[w] = dist[u] + 1;
+                    queue.push_back(w);
+                }
+            }
+        }
+        if (limit == unreached)
+        {
+            return phases;
+        }
+        ++phases;
+
+        // Depth-first search along the layers from every exposed node of color 0. Nodes that lead to no exposed node
+        // are cut off by resetting their distance, so every node is left at most once per phase.
+        for (NodeId v = 0; v < g.num_nodes(); ++v)
+        {
+            next[v] = 0;
+        }
+        for (size_t i = 0; i < num_roots; ++i)
+        {
+            stack.assign(1, queue[i]);
+            while (!stack.empty())
+            {
+                NodeId u = stack.back();
+                const auto neighbors = g.node(u).neighbors();
+                if (next[u] == neighbors.size())
+                {
+                    dist[u] = unreached;
+                    stack.pop_back();
+                    continue;
+                }
+                NodeId v = neighbors[next[u]++];
+                NodeId w = mate[v];
+                if (w == v && dist[u] == limit)
+                {
+                    // Augment: every node on the stack takes the neighbor of color 1 its successor came from.
+                    for (size_t k = stack.size(); k-- > 0;)
+                    {
+                        NodeId previous = mate[stack[k]];
+                        mate[stack[k]] = v;
+                        mate[v] = stack[k];
+                        v = previous;
+                    }
+                    stack.clear();
+                }
+                else if (w != v && dist[w] == dist[u] + 1)
+                {
+                    stack.push_back(w);
+                }
+            }
+        }
+    }
+}
+
+} // namespace ED
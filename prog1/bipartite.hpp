@@ -0,0 +1,37 @@
+#ifndef BIPARTITE_HPP
+#define BIPARTITE_HPP
+
+#include "graph.hpp"
+
+#include <vector>
+
+/**
+ * @file bipartite.hpp
+ *
+ * @brief This file provides a test for bipartiteness and the Hopcroft–Karp algorithm, which finds a maximum matching
+ * of a bipartite graph in O(m sqrt(n)) time without any blossom handling.
+ *
+ * Matchings are given as mate arrays in the convention of initial_matching.hpp.
+ */
+namespace ED
+{
+/**
+ * Tries to 2-color @c g by breadth-first search, stopping at the first edge between two nodes of the same color. Takes
+ * O(n + m) time, and usually much less on graphs with short odd cycles.
+ * @param side Receives the color (0 or 1) of every node if @c g is bipartite.
+ * @return True, if @c g is bipartite.
+ */
+bool two_coloring(const Graph &g, std::vector<unsigned char> &side);
+
+/**
+ * Augments the matching @c mate of the bipartite graph @c g to a maximum matching. Every phase finds the length of a
+ * shortest augmenting path by breadth-first search from the exposed nodes of color 0 and then augments along a
+ * maximal set of vertex-disjoint shortest augmenting paths.
+ * @param side A 2-coloring of @c g as computed by @c two_coloring.
+ * @return The number of phases.
+ */
+size_type hopcroft_karp(const Graph &g, const std::vector<unsigned char> &side, std::vector<NodeId> &mate);
+
+} // namespace ED
+
+#endif // BIPARTITE_HPP
@@ -0,0 +1,26 @@
+#include "bitset_adjacency.hpp"
+
+namespace ED
+{
+BitsetAdjacency::BitsetAdjacency(const Graph &g) : _num_words((g.num_nodes() + word_bits - 1) / word_bits),
+                                                   _rows(g.num_nodes() * _num_words, 0)
+{
+    for (NodeId v = 0; v < g.num_nodes(); ++v)
+    {
+        Word *row = _rows.data() + v * _num_words;
+        for (auto w : g.node(v).neighbors())
+        {
+            row[w / word_bits] |= Word(1) << (w % word_bits);
+        }
+    }
+}
+
+bool BitsetAdjacency::suits(const Graph &g, size_type exposed)
+{
+    size_type const n = g.num_nodes();
+    size_type const max_words = size_type(1) << 25;
+    size_type const num_words = (n + word_bits - 1) / word_bits;
+    return n > 0 && 2 * g.num_edges() * 32 >= n * n && num_words <= max_words / n && exposed * word_bits >= n;
+}
+
+} // namespace ED
@@ -0,0 +1,140 @@
+#ifndef BITSET_ADJACENCY_HPP
+#define BITSET_ADJACENCY_HPP
+
+#include "graph.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file bitset_adjacency.hpp
+ *
+ * @brief This file provides bitsets over the nodes of a graph and an adjacency matrix made of them, for dense graphs.
+ * A row of the matrix costs n / 64 word operations to scan instead of one operation per neighbor, and combining it
+ * with bitsets of node states (e.g. the nodes of the forest) filters the neighbors 64 at a time.
+ */
+namespace ED
+{
+using Word = std::uint64_t;
+unsigned constexpr word_bits = 64;
+
+/**
+ * Calls @c f with the id of every node whose bit is set in @c word, the word with index @c word_index of a bitset, in
+ * increasing order.
+ */
+template <typename func>
+void for_each_bit(Word word, size_type word_index, func f)
+{
+    while (word != 0)
+    {
+        f(static_cast<NodeId>(word_index * word_bits + __builtin_ctzll(word)));
+        word &= word - 1;
+    }
+}
+
+/**
+ * @class NodeBitset
+ *
+ * @brief A set of the nodes 0, ..., n-1 with one bit per node.
+ */
+class NodeBitset
+{
+  public:
+    /**
+     * Creates an empty set, or an empty placeholder for @c n == 0.
+     */
+    explicit NodeBitset(NodeId n) : _words((n + word_bits - 1) / word_bits, 0)
+    {
+    }
+
+    void set(NodeId v);
+    void reset(NodeId v);
+    bool test(NodeId v) const;
+
+    /**
+     * Removes all nodes in O(n / 64) time.
+     */
+    void clear();
+
+    Word word(size_type i) const;
+
+  private:
+    std::vector<Word> _words;
+};
+
+/**
+ * @class BitsetAdjacency
+ *
+ * @brief The adjacency matrix of a @c Graph as one bitset row per node. Parallel edges collapse into one bit. Needs
+ * n^2 / 8 bytes.
+ */
+class BitsetAdjacency
+{
+  public:
+    explicit BitsetAdjacency(const Graph &g);
+
+    /**
+     * @param exposed The number of nodes exposed by the initial matching.
+     * @return Whether @c g is dense enough for the rows to be scanned faster than its neighbor lists, i.e. the average
+     * degree is at least n / 32 (so a row has at most two words per neighbor), and the matrix takes at most 256 MiB.
+     * Also at least n / 64 nodes have to be exposed, otherwise the few searches do not pay for building the matrix.
+     */
+    static bool suits(const Graph &g, size_type exposed);
+
+    /**
+     * @return The number of words of every row.
+     */
+    size_type num_words() const;
+
+    /**
+     * @return The words of the row of @c v.
+     */
+    const Word *row(NodeId v) const;
+
+  private:
+    size_type _num_words;
+    std::vector<Word> _rows;
+};
+
+// BEGIN: Inline section
+
+inline void NodeBitset::set(NodeId v)
+{
+    _words[v / word_bits] |= Word(1) << (v % word_bits);
+}
+
+inline void NodeBitset::reset(NodeId v)
+{
+    _words[v / word_bits] &= ~(Word(1) << (v % word_bits));
+}
+
+inline bool NodeBitset::test(NodeId v) const
+{
+    return (_words[v / word_bits] >> (v % word_bits)) & 1;
+}
+
+inline void NodeBitset::clear()
+{
+    std::fill(_words.begin(), _words.end(), 0);
+}
+
+inline Word NodeBitset::word(size_type i) const
+{
+    return _words[i];
+}
+
+inline size_type BitsetAdjacency::num_words() const
+{
+    return _num_words;
+}
+
+inline const Word *BitsetAdjacency::row(NodeId v) const
+{
+    return _rows.data() + v * _num_words;
+}
+
+// END: Inline section
+} // namespace ED
+
+#endif // BITSET_ADJACENCY_HPP
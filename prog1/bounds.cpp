@@ -0,0 +1,83 @@
+#include "bounds.hpp"
+
+#include "union_find.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace ED
+{
+MatchingBound matching_upper_bound(const Graph &g)
+{
+    NodeId const n = g.num_nodes();
+    MatchingBound bound;
+
+    UnionFind components(n);
+    std::vector<size_type> size(n, 0);
+    for (NodeId v = 0; v < n; ++v)
+    {
+        bool isolated = true;
+        for (auto w : g.node(v).neighbors())
+        {
+            if (w != v)
+            {
+                components.unite(v, w);
+                isolated = false;
+            }
+        }
+        bound.isolated += isolated ? 1 : 0;
+    }
+    for (NodeId v = 0; v < n; ++v)
+    {
+        ++size[components.find(v)];
+    }
+    for (NodeId v = 0; v < n; ++v)
+    {
+        bound.odd_components += size[v] % 2;
+    }
+
+    // Sorts the nodes by degree (by counting) and takes every node none of whose neighbors has been taken.
+    size_type max_degree = 0;
+    for (NodeId v = 0; v < n; ++v)
+    {
+        max_degree = std::max(max_degree, g.node(v).degree());
+    }
+    std::vector<size_type> start(max_degree + 2, 0);
+    for (NodeId v = 0; v < n; ++v)
+    {
+        ++start[g.node(v).degree() + 1];
+    }
+    for (size_type d = 1; d < start.size(); ++d)
+    {
+        start[d] += start[d - 1];
+    }
+    std::vector<NodeId> order(n);
+    for (NodeId v = 0; v < n; ++v)
+    {
+        order[start[g.node(v).degree()]++] = v;
+    }
+
+    std::vector<unsigned char> blocked(n, false);
+    size_type independent = 0;
+    for (auto v : order)
+    {
+        if (blocked[v])
+        {
+            continue;
+        }
+        ++independent;
+        for (auto w : g.node(v).neighbors())
+        {
+            if (w != v)
+            {
+                blocked[w] = true;
+            }
+        }
+    }
+    bound.cover = n - independent;
+
+    bound.value = std::min((n - bound.odd_components) / 2, bound.cover);
+    return bound;
+}
+
+} // namespace ED
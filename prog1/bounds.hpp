@@ -0,0 +1,38 @@
+#ifndef BOUNDS_HPP
+#define BOUNDS_HPP
+
+#include "graph.hpp"
+
+/**
+ * @file bounds.hpp
+ *
+ * @brief This file provides a cheap upper bound on the size of a maximum matching. Once a matching reaches it, the
+ * matching is maximum and the search can stop, without the final passes that only prove that no augmenting path is
+ * left.
+ */
+namespace ED
+{
+/**
+ * The parts of the bound of @c matching_upper_bound.
+ */
+struct MatchingBound
+{
+    size_type odd_components = 0; //!< Number of connected components with an odd number of nodes.
+    size_type isolated = 0;       //!< Number of nodes without neighbors (other than themselves), among them.
+    size_type cover = 0;          //!< Size of the vertex cover found greedily.
+    size_type value = 0;          //!< The bound, the smaller one of (n - odd_components) / 2 and @c cover.
+};
+
+/**
+ * Computes two upper bounds on the size of a maximum matching of @c g, in O(n + m) time (up to the inverse Ackermann
+ * function):
+ *  - Every odd component (e.g. an isolated node) leaves at least one node exposed, so at most
+ *    (n - odd_components) / 2 edges are matched.
+ *  - Every matching edge needs its own node of a vertex cover. The cover consists of the nodes outside of an
+ *    independent set, which is grown greedily in order of increasing degree.
+ */
+MatchingBound matching_upper_bound(const Graph &g);
+
+} // namespace ED
+
+#endif // BOUNDS_HPP
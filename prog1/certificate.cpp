@@ -0,0 +1,125 @@
+#include "certificate.hpp"
+
+#include "dimacs_writer.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace ED
+{
+void write_certificate(DIMACS::Writer &out, const std::vector<NodeId> &set)
+{
+    out.put("c Tutte-Berge set: one node per line\n");
+    for (auto v : set)
+    {
+        out.put_unsigned(to_dimacs_id(v));
+        out.put('\n');
+    }
+}
+
+std::vector<NodeId> read_certificate(const std::string &filename)
+{
+    std::ifstream file(filename);
+    if (!file)
+    {
+        throw std::runtime_error("Cannot open certificate file " + filename + ".");
+    }
+    std::vector<NodeId> set;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (!line.empty() && line[0] != 'c')
+        {
+            set.push_back(from_dimacs_id(std::stoull(line)));
+        }
+    }
+    return set;
+}
+
+CertificateCheck check_certificate(const Graph &g, const Graph &matching, const std::vector<NodeId> &set)
+{
+    CertificateCheck check;
+    NodeId const n = g.num_nodes();
+    if (matching.num_nodes() != n)
+    {
+        check.error = "The matching has " + std::to_string(matching.num_nodes()) + " nodes, the graph " +
+                      std::to_string(n) + ".";
+        return check;
+    }
+
+    // The matching: every node has at most one matching edge, which is an edge of the graph.
+    for (NodeId v = 0; v < n; ++v)
+    {
+        NodeIdRange mates = matching.node(v).neighbors();
+        if (mates.size() > 1)
+        {
+            check.error = "Node " + std::to_string(to_dimacs_id(v)) + " has more than one matching edge.";
+            return check;
+        }
+        if (mates.empty() || mates[0] < v)
+        {
+            continue;
+        }
+        NodeIdRange neighbors = g.node(v).neighbors();
+        if (std::find(neighbors.begin(), neighbors.end(), mates[0]) == neighbors.end())
+        {
+            check.error = "The matching edge {" + std::to_string(to_dimacs_id(v)) + ", " +
+                          std::to_string(to_dimacs_id(mates[0])) + "} is not an edge of the graph.";
+            return check;
+        }
+        ++check.matching_size;
+    }
+
+    // The set, whose nodes are marked as visited so that the components of G - U are found by searching the rest.
+    std::vector<unsigned char> visited(n, false);
+    for (auto v : set)
+    {
+        if (v >= n || visited[v])
+        {
+            check.error = "The set contains an invalid or repeated node.";
+            return check;
+        }
+        visited[v] = true;
+    }
+
+    size_type odd_components = 0;
+    std::vector<NodeId> stack;
+    for (NodeId start = 0; start < n; ++start)
+    {
+        if (visited[start])
+        {
+            continue;
+        }
+        visited[start] = true;
+        stack.assign(1, start);
+        size_type size = 0;
+        while (!stack.empty())
+        {
+            NodeId v = stack.back();
+            stack.pop_back();
+            ++size;
+            for (auto w : g.node(v).neighbors())
+            {
+                if (!visited[w])
+                {
+                    visited[w] = true;
+                    stack.push_back(w);
+                }
+            }
+        }
+        odd_components += size % 2;
+    }
+
+    // n - |U| and odd(G - U) have the same parity, so the bound is an integer.
+    check.bound = (n + set.size() - odd_components) / 2;
+    check.valid = check.matching_size == check.bound;
+    if (!check.valid)
+    {
+        check.error = "The matching has " + std::to_string(check.matching_size) + " edges, but the set only bounds " +
+                      "the maximum by " + std::to_string(check.bound) + ".";
+    }
+    return check;
+}
+
+} // namespace ED
@@ -0,0 +1,54 @@
+#ifndef CERTIFICATE_HPP
+#define CERTIFICATE_HPP
+
+#include "graph.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * @file certificate.hpp
+ *
+ * @brief This file provides optimality certificates for maximum matchings. By the Tutte–Berge formula, every matching
+ * of a graph @c G has at most (n + |U| - odd(G - U)) / 2 edges for every set @c U of nodes, where odd(G - U) is the
+ * number of connected components of G - U with an odd number of nodes, and equality holds for some @c U. Such a set
+ * proves that a matching attaining the bound is maximum, which can be checked in O(n + m) time. The inner nodes of the
+ * forest @c EdmondsMatching ends with are such a set (see @c EdmondsMatching::tutte_berge_set).
+ */
+namespace DIMACS
+{
+class Writer;
+} // namespace DIMACS
+
+namespace ED
+{
+/**
+ * The outcome of @c check_certificate.
+ */
+struct CertificateCheck
+{
+    bool valid = false;          //!< Whether the matching is valid and attains the bound, i.e. is maximum.
+    std::string error;           //!< Why the check failed, if it did.
+    size_type matching_size = 0; //!< Number of edges of the matching.
+    size_type bound = 0;         //!< The Tutte–Berge bound (n + |U| - odd(G - U)) / 2 of the set.
+};
+
+/**
+ * Writes @c set as one DIMACS id per line, after a comment line.
+ */
+void write_certificate(DIMACS::Writer &out, const std::vector<NodeId> &set);
+
+/**
+ * @return The set stored in @c filename by @c write_certificate.
+ */
+std::vector<NodeId> read_certificate(const std::string &filename);
+
+/**
+ * Checks that @c matching (e.g. from @c read_matching) is a matching of @c g, i.e. has the same nodes and only edges
+ * of @c g that do not share a node, and that @c set proves it maximum. Takes O(n + m) time.
+ */
+CertificateCheck check_certificate(const Graph &g, const Graph &matching, const std::vector<NodeId> &set);
+
+} // namespace ED
+
+#endif // CERTIFICATE_HPP
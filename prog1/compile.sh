@@ -1,2 +1,3 @@
 #!/bin/bash
-g++ -std=c++11 -O3 -pedantic -Wall -Wextra -Werror -o edmonds.out *.cpp
+# Extra flags are passed on, e.g. -DDIMACS_INDEX32 for 32-bit node ids (see ../common/index_type.hpp).
+g++ -std=c++11 -O3 -pedantic -Wall -Wextra -Werror -pthread -I../common -o edmonds.out graph.cpp alternating_tree.cpp approximate.cpp bipartite.cpp bitset_adjacency.cpp bounds.cpp certificate.cpp components.cpp edmonds.cpp initial_matching.cpp kernel.cpp main.cpp renumbering.cpp ../common/*.cpp "$@"
@@ -0,0 +1,99 @@
+#include "components.hpp"
+
+#include "parallel.hpp"
+#include "union_find.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace ED
+{
+ComponentSplit::ComponentSplit(const Graph &g, unsigned num_threads) : _g(g)
+{
+    NodeId const n = g.num_nodes();
+    unsigned const num_tasks =
+        static_cast<unsigned>(std::max<size_type>(1, std::min<size_type>(DIMACS::resolve_thread_count(num_threads), n)));
+
+    std::vector<UnionFind> parts(num_tasks, UnionFind(0));
+    DIMACS::run_parallel(num_tasks, [&g, &parts, n, num_tasks](unsigned task) {
+        UnionFind sets(n);
+        for (NodeId v = n * task / num_tasks; v < n * (task + 1) / num_tasks; ++v)
+        {
+            for (auto w : g.node(v).neighbors())
+            {
+                sets.unite(v, w);
+            }
+        }
+        parts[task] = std::move(sets);
+    });
+
+    // Merge the other structures into the first one: every node has to end up in the set of its representative there.
+    UnionFind &sets = parts[0];
+    for (unsigned task = 1; task < num_tasks; ++task)
+    {
+        for (NodeId v = 0; v < n; ++v)
+        {
+            NodeId rep = parts[task].find(v);
+            if (rep != v)
+            {
+                sets.unite(v, rep);
+            }
+        }
+    }
+
+    // Number the components by their smallest node and sort the nodes by component (stably, by counting).
+    size_type const unnumbered = std::numeric_limits<size_type>::max();
+    std::vector<size_type> number(n, unnumbered);
+    _component.resize(n);
+    _offsets.assign(1, 0);
+    for (NodeId v = 0; v < n; ++v)
+    {
+        NodeId rep = sets.find(v);
+        if (number[rep] == unnumbered)
+        {
+            number[rep] = _offsets.size() - 1;
+            _offsets.push_back(0);
+        }
+        _component[v] = number[rep];
+        ++_offsets[_component[v] + 1];
+    }
+    for (size_type c = 1; c < _offsets.size(); ++c)
+    {
+        _offsets[c] += _offsets[c - 1];
+    }
+
+    _nodes.resize(n);
+    _local_id.resize(n);
+    std::vector<size_type> fill(_offsets.begin(), _offsets.end() - 1);
+    for (NodeId v = 0; v < n; ++v)
+    {
+        size_type c = _component[v];
+        _local_id[v] = fill[c] - _offsets[c];
+        _nodes[fill[c]++] = v;
+    }
+}
+
+Graph ComponentSplit::subgraph(size_type c) const
+{
+    NodeIdRange members = nodes(c);
+    size_type num_edges = 0;
+    for (auto v : members)
+    {
+        num_edges += _g.node(v).degree();
+    }
+
+    GraphBuilder builder(members.size(), num_edges / 2);
+    for (auto v : members)
+    {
+        for (auto w : _g.node(v).neighbors())
+        {
+            if (v < w)
+            {
+                builder.add_edge(_local_id[v], _local_id[w]);
+            }
+        }
+    }
+    return builder.build();
+}
+
+} // namespace ED
@@ -0,0 +1,89 @@
+#ifndef COMPONENTS_HPP
+#define COMPONENTS_HPP
+
+#include "graph.hpp"
+
+#include <vector>
+
+/**
+ * @file components.hpp
+ *
+ * @brief This file provides the partition of a graph into its connected components. A maximum matching of a graph is
+ * the union of maximum matchings of its components, so they can be solved independently.
+ */
+namespace ED
+{
+/**
+ * @class ComponentSplit
+ *
+ * @brief The connected components of a @c Graph, numbered by their smallest node, together with the nodes of every
+ * component in increasing order. The position of a node in its component is its id in the component's subgraph.
+ */
+class ComponentSplit
+{
+  public:
+    /**
+     * Finds the components of @c g. Every one of @c num_threads threads (0 meaning one per hardware thread) unites the
+     * endpoints of the edges of a range of nodes in its own union-find structure, these are then merged. Takes
+     * O((n + m) / num_threads + n * num_threads) time.
+     */
+    ComponentSplit(const Graph &g, unsigned num_threads);
+
+    size_type num_components() const;
+
+    /**
+     * @return The component containing @c v.
+     */
+    size_type component(NodeId v) const;
+
+    /**
+     * @return The id of @c v in the subgraph of its component.
+     */
+    NodeId local_id(NodeId v) const;
+
+    /**
+     * @return The nodes of component @c c in increasing order, i.e. the node with id @c i in the subgraph of @c c is
+     * at position @c i.
+     */
+    NodeIdRange nodes(size_type c) const;
+
+    /**
+     * @return The subgraph induced by component @c c, with its nodes renumbered as in @c nodes.
+     */
+    Graph subgraph(size_type c) const;
+
+  private:
+    const Graph &_g;
+    std::vector<size_type> _component;
+    std::vector<NodeId> _local_id;
+    //! The nodes of component @c c are <tt>_nodes[_offsets[c]], ..., _nodes[_offsets[c + 1] - 1]</tt>.
+    std::vector<size_type> _offsets;
+    std::vector<NodeId> _nodes;
+};
+
+// BEGIN: Inline section
+
+inline size_type ComponentSplit::num_components() const
+{
+    return _offsets.size() - 1;
+}
+
+inline size_type ComponentSplit::component(NodeId v) const
+{
+    return _component[v];
+}
+
+inline NodeId ComponentSplit::local_id(NodeId v) const
+{
+    return _local_id[v];
+}
+
+inline NodeIdRange ComponentSplit::nodes(size_type c) const
+{
+    return NodeIdRange(_nodes.data() + _offsets[c], _nodes.data() + _offsets[c + 1]);
+}
+
+// END: Inline section
+} // namespace ED
+
+#endif // COMPONENTS_HPP
@@ -0,0 +1,27 @@
+#include <iostream>
+#include <cstdlib>
+
+#include "binary_graph.hpp"
+#include "graph.hpp"
+
+/**
+   Converts DIMACS files into binary caches (@c foo.dmx into @c foo.dmxb next to it). Afterwards
+   @c ED::Graph::build_graph picks up the cache automatically as long as the DIMACS file is unchanged.
+**/
+int main(int argc, char **argv)
+{
+   if (argc < 2)
+   {
+      std::cerr << "Wrong number of arguments. Program call: <program_name> <input_graph>..." << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   for (int i = 1; i < argc; ++i)
+   {
+      ED::Graph graph = ED::Graph::parse_dimacs(argv[i]);
+      graph.write_binary_cache(argv[i]);
+      std::cout << argv[i] << " -> " << DIMACS::binary_cache_path(argv[i]) << std::endl;
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,92 @@
+#include "dynamic_graph.hpp"
+
+#include <algorithm>
+
+namespace ED
+{
+
+DynamicGraph::DynamicGraph(NodeId const num_nodes)
+   :
+   _adjacency(num_nodes),
+   _num_edges(0)
+{}
+
+DynamicGraph::DynamicGraph(Graph const & graph)
+   :
+   _adjacency(graph.num_nodes()),
+   _num_edges(graph.num_edges())
+{
+   for (NodeId node_id = 0; node_id < graph.num_nodes(); ++node_id)
+   {
+      NodeIdRange const neighbors = graph.node(node_id).neighbors();
+      _adjacency[node_id].assign(neighbors.begin(), neighbors.end());
+   }
+}
+
+void DynamicGraph::add_edge(NodeId const node1_id, NodeId const node2_id)
+{
+   if (node1_id == node2_id)
+   {
+      throw std::runtime_error("ED::DynamicGraph class does not support loops!");
+   }
+   if (node1_id >= num_nodes() or node2_id >= num_nodes())
+   {
+      throw std::out_of_range("Edge endpoint is not a node of the graph.");
+   }
+
+   _adjacency[node1_id].push_back(node2_id);
+   _adjacency[node2_id].push_back(node1_id);
+   ++_num_edges;
+}
+
+bool DynamicGraph::remove_edge(NodeId const node1_id, NodeId const node2_id)
+{
+   if (node1_id >= num_nodes() or node2_id >= num_nodes())
+   {
+      throw std::out_of_range("Edge endpoint is not a node of the graph.");
+   }
+
+   // Removes one entry from a list by moving the last one into its place.
+   auto const remove_entry = [](std::vector<NodeId> & neighbors, NodeId const neighbor) {
+      auto const it = std::find(neighbors.begin(), neighbors.end(), neighbor);
+      if (it == neighbors.end())
+      {
+         return false;
+      }
+      *it = neighbors.back();
+      neighbors.pop_back();
+      return true;
+   };
+
+   if (not remove_entry(_adjacency[node1_id], node2_id))
+   {
+      return false;
+   }
+   remove_entry(_adjacency[node2_id], node1_id);
+   --_num_edges;
+   return true;
+}
+
+bool DynamicGraph::has_edge(NodeId const node1_id, NodeId const node2_id) const
+{
+   NodeIdRange const neighbors = node(node1_id).neighbors();
+   return std::find(neighbors.begin(), neighbors.end(), node2_id) != neighbors.end();
+}
+
+Graph DynamicGraph::to_graph() const
+{
+   GraphBuilder builder(num_nodes(), _num_edges);
+   for (NodeId node1_id = 0; node1_id < num_nodes(); ++node1_id)
+   {
+      for (NodeId const node2_id : _adjacency[node1_id])
+      {
+         if (node1_id < node2_id)
+         {
+            builder.add_edge(node1_id, node2_id);
+         }
+      }
+   }
+   return builder.build();
+}
+
+} // namespace ED
@@ -0,0 +1,105 @@
+#ifndef DYNAMIC_GRAPH_HPP
+#define DYNAMIC_GRAPH_HPP
+
+/**
+   @file dynamic_graph.hpp
+
+   @brief This file provides a mutable counterpart @c DynamicGraph of the immutable @c Graph, to which edges can be
+   added and from which they can be removed.
+**/
+
+#include "graph.hpp"
+
+#include <vector>
+
+namespace ED // for Edmonds
+{
+
+/**
+   @class DynamicGraph
+
+   @brief A @c DynamicGraph keeps one adjacency vector per node, so adding an edge takes amortized constant time and
+   removing one takes time proportional to the degrees of its endpoints.
+
+   The number of nodes is fixed. Like @c Graph, this class forbids loops, but parallel edges are legal. The order of
+   the neighbors of a node changes when an edge at it is removed.
+**/
+class DynamicGraph
+{
+public:
+   typedef std::size_t size_type;
+
+   /** @brief Creates a graph with @c num_nodes isolated nodes. **/
+   explicit DynamicGraph(NodeId const num_nodes);
+
+   /** @brief Creates a copy of @c graph that can be changed. **/
+   explicit DynamicGraph(Graph const & graph);
+
+   /** @return The number of nodes in the graph. **/
+   NodeId num_nodes() const;
+
+   /** @return The number of edges in the graph. **/
+   size_type num_edges() const;
+
+   /**
+      @return A view of the id-th node of this graph.
+
+      @warning The view is invalidated by the next change at this node.
+   **/
+   Node node(NodeId const id) const;
+
+   /**
+      @brief Adds the edge <tt> {node1_id, node2_id} </tt>.
+
+      Checks that @c node1_id and @c node2_id are distinct and existing nodes and throws an exception otherwise.
+   **/
+   void add_edge(NodeId const node1_id, NodeId const node2_id);
+
+   /**
+      @brief Removes one edge <tt> {node1_id, node2_id} </tt>.
+
+      @return Whether there was such an edge.
+   **/
+   bool remove_edge(NodeId const node1_id, NodeId const node2_id);
+
+   /** @return Whether the graph contains an edge <tt> {node1_id, node2_id} </tt>. **/
+   bool has_edge(NodeId const node1_id, NodeId const node2_id) const;
+
+   /** @return The current graph as a @c Graph. **/
+   Graph to_graph() const;
+
+private:
+   std::vector<std::vector<NodeId>> _adjacency;
+   size_type _num_edges;
+}; // class DynamicGraph
+
+//BEGIN: Inline section
+
+inline
+NodeId DynamicGraph::num_nodes() const
+{
+   return _adjacency.size();
+}
+
+inline
+DynamicGraph::size_type DynamicGraph::num_edges() const
+{
+   return _num_edges;
+}
+
+inline
+Node DynamicGraph::node(NodeId const id) const
+{
+   // perform index checking
+   if (id >= num_nodes())
+   {
+      throw std::out_of_range("Invalid node id.");
+   }
+   std::vector<NodeId> const & neighbors = _adjacency[id];
+   return Node(NodeIdRange(neighbors.data(), neighbors.data() + neighbors.size()));
+}
+//END: Inline section
+
+} // namespace ED
+
+#endif /* DYNAMIC_GRAPH_HPP */
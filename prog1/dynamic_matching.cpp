@@ -0,0 +1,99 @@
+#include "dynamic_matching.hpp"
+
+#include <stdexcept>
+
+namespace ED
+{
+DynamicMatching::DynamicMatching(const Graph &g, const MatchingOptions &options)
+    : _g(g), _mu(EdmondsMatching::get_mates(g, options)), _size(matching_size(_mu)), _tree(g.num_nodes())
+{
+}
+
+void DynamicMatching::insert_edge(NodeId a, NodeId b)
+{
+    _g.add_edge(a, b);
+    ++_stats.insertions;
+
+    if (_mu[a] == a && _mu[b] == b)
+    {
+        match(a, b);
+        return;
+    }
+    if (_mu[a] == a || _mu[b] == b)
+    {
+        search(_mu[a] == a ? a : b, invalid_node_id);
+        return;
+    }
+    if (_mu[a] == b)
+    {
+        return;
+    }
+
+    // Both endpoints are matched. Without the matching edge {a, c}, every augmenting path ends in a or c: otherwise it
+    // would avoid the new edge and augment the old matching. If the maximum size grew, there are two disjoint such
+    // paths, one from a to another exposed node than c, and one from c. So if there is no path from a that avoids c,
+    // the old size is still the maximum. The search from a must not end in c, since this would only restore the old
+    // size and could leave the path from c undetected.
+    NodeId c = _mu[a];
+    _mu[a] = a;
+    _mu[c] = c;
+    --_size;
+    if (search(a, c))
+    {
+        search(c, invalid_node_id);
+    }
+    else
+    {
+        match(a, c);
+    }
+}
+
+void DynamicMatching::delete_edge(NodeId a, NodeId b)
+{
+    if (!_g.remove_edge(a, b))
+    {
+        throw std::runtime_error("Cannot delete an edge that is not in the graph.");
+    }
+    ++_stats.deletions;
+
+    if (_mu[a] != b || _g.has_edge(a, b))
+    {
+        return;
+    }
+    _mu[a] = a;
+    _mu[b] = b;
+    --_size;
+    // One augmenting path restores the size, and it ends in a or b: otherwise it would augment the old matching.
+    if (!search(a, invalid_node_id))
+    {
+        search(b, invalid_node_id);
+    }
+}
+
+void DynamicMatching::match(NodeId a, NodeId b)
+{
+    _mu[a] = b;
+    _mu[b] = a;
+    ++_size;
+}
+
+bool DynamicMatching::search(NodeId root, NodeId blocked)
+{
+    // Without another exposed node there is nothing to search for, which is common once the matching is perfect.
+    size_type const num_exposed = _g.num_nodes() - 2 * _size;
+    if (num_exposed - 1 == (blocked != invalid_node_id && _mu[blocked] == blocked ? 1 : 0))
+    {
+        return false;
+    }
+    ++_stats.searches;
+    bool const found = _tree.search(_g, _mu, root, AlternatingTree::unlimited_depth, blocked);
+    _stats.tree_nodes += _tree.nodes().size();
+    if (found)
+    {
+        ++_size;
+        ++_stats.augmentations;
+    }
+    return found;
+}
+
+} // namespace ED
@@ -0,0 +1,130 @@
+#ifndef DYNAMIC_MATCHING_HPP
+#define DYNAMIC_MATCHING_HPP
+
+#include "alternating_tree.hpp"
+#include "dynamic_graph.hpp"
+#include "edmonds.hpp"
+
+#include <vector>
+
+/**
+ * @file dynamic_matching.hpp
+ *
+ * @brief This file provides a maximum matching that is kept up to date while edges are inserted into and deleted from
+ * the graph. Instead of solving the changed graph again, every update searches only for the augmenting paths the
+ * change can have created, each with a single alternating tree grown from one exposed node.
+ */
+namespace ED
+{
+/**
+ * What the updates of a @c DynamicMatching did.
+ */
+struct DynamicStatistics
+{
+    size_type insertions = 0;    //!< Number of inserted edges.
+    size_type deletions = 0;     //!< Number of deleted edges.
+    size_type searches = 0;      //!< Number of alternating trees grown.
+    size_type augmentations = 0; //!< Number of searches that found an augmenting path.
+    size_type tree_nodes = 0;    //!< Total number of nodes of all trees, i.e. the work done by the searches.
+};
+
+/**
+ * @class DynamicMatching
+ *
+ * @brief A @c DynamicGraph together with a maximum matching of it, repaired locally after every change:
+ *  - Inserting an edge increases the size of a maximum matching by at most one, and every new augmenting path uses
+ *    the edge. If an endpoint is exposed, the path ends there, so one search from it suffices. If both endpoints are
+ *    matched, the matching edge at one of them is removed first. Then every augmenting path ends in one of the two
+ *    nodes of that edge, and at most two searches from them are needed (usually one, if the size does not grow).
+ *  - Deleting an unmatched edge leaves the matching maximum. Deleting a matched edge decreases the size of a maximum
+ *    matching by at most one, and every augmenting path ends in one of the two newly exposed nodes.
+ *
+ * A search costs time proportional to the total degree of the nodes of its tree (times the inverse Ackermann function
+ * for the blossoms), and the tree contains only nodes reachable from its root by alternating paths.
+ */
+class DynamicMatching
+{
+  public:
+    /**
+     * Computes a maximum matching of @c g with @c EdmondsMatching::get_mates using @c options.
+     */
+    explicit DynamicMatching(const Graph &g, const MatchingOptions &options = MatchingOptions());
+
+    /**
+     * Adds the edge {a, b} (throws like @c DynamicGraph::add_edge) and repairs the matching.
+     */
+    void insert_edge(NodeId a, NodeId b);
+
+    /**
+     * Removes one edge {a, b} and repairs the matching. Throws if there is no such edge.
+     */
+    void delete_edge(NodeId a, NodeId b);
+
+    const DynamicGraph &graph() const;
+
+    /**
+     * @return The node matched to @c v, or @c v if it is exposed.
+     */
+    NodeId mate(NodeId v) const;
+
+    /**
+     * @return The matching as mate array (see initial_matching.hpp).
+     */
+    const std::vector<NodeId> &mates() const;
+
+    /**
+     * @return The number of edges of the matching.
+     */
+    size_type size() const;
+
+    const DynamicStatistics &statistics() const;
+
+  private:
+    void match(NodeId a, NodeId b);
+
+    /**
+     * Searches for an augmenting path from the exposed node @c root with @c AlternatingTree::search, ignoring the
+     * node @c blocked (which may be @c invalid_node_id), and augments the matching along it.
+     * @return Whether an augmenting path was found.
+     */
+    bool search(NodeId root, NodeId blocked);
+
+    DynamicGraph _g;
+    std::vector<NodeId> _mu;
+    size_type _size;
+    AlternatingTree _tree;
+
+    DynamicStatistics _stats;
+};
+
+// BEGIN: Inline section
+
+inline const DynamicGraph &DynamicMatching::graph() const
+{
+    return _g;
+}
+
+inline NodeId DynamicMatching::mate(NodeId v) const
+{
+    return _mu[v];
+}
+
+inline const std::vector<NodeId> &DynamicMatching::mates() const
+{
+    return _mu;
+}
+
+inline size_type DynamicMatching::size() const
+{
+    return _size;
+}
+
+inline const DynamicStatistics &DynamicMatching::statistics() const
+{
+    return _stats;
+}
+
+// END: Inline section
+} // namespace ED
+
+#endif // DYNAMIC_MATCHING_HPP
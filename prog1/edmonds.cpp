@@ -1,137 +1,587 @@
 #include "edmonds.hpp"
 
+#include "binary_graph.hpp"
+#include "components.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
 namespace ED
 {
+namespace
+{
+//! Bits of the flags array of a checkpoint.
+unsigned char constexpr scanned_flag = 1;
+unsigned char constexpr frozen_flag = 2;
 
-Graph EdmondsMatching::get_matching(const Graph &g)
+//! A checkpoint holds the arrays phi, mu and rho of n node ids each, the flags of the nodes and the engine.
+std::size_t checkpoint_payload_size(DIMACS::BinaryHeader const &header)
 {
+    return 3 * DIMACS::aligned_size(header.num_nodes * sizeof(NodeId)) + DIMACS::aligned_size(header.num_nodes) +
+           DIMACS::aligned_size(sizeof(std::uint32_t));
+}
 
-    EdmondsMatching match(g);
-    match.run();
-    return match.populate();
+//! The offset of the engine in the payload of a checkpoint of a graph with @c num_nodes nodes.
+std::size_t checkpoint_engine_offset(std::uint64_t num_nodes)
+{
+    return 3 * DIMACS::aligned_size(num_nodes * sizeof(NodeId)) + DIMACS::aligned_size(num_nodes);
 }
 
-Graph EdmondsMatching::populate() const
+std::shared_ptr<const DIMACS::MappedFile> map_checkpoint(const Graph &g, const std::string &filename, Engine engine)
 {
-    Graph g(_g.num_nodes());
-    for (NodeId v = 0; v < g.num_nodes(); ++v)
+    auto file = DIMACS::map_binary(
+        filename, DIMACS::BinaryKind::checkpoint, sizeof(NodeId), 0, checkpoint_payload_size);
+    auto const &header = DIMACS::binary_header(*file);
+    if (header.num_nodes != g.num_nodes() || header.num_edges != g.num_edges())
+    {
+        throw std::runtime_error("The checkpoint belongs to another graph.");
+    }
+    // The frozen flags only mean something to Engine::phases, and Engine::edmonds would never scan those trees again.
+    if (*DIMACS::binary_array<std::uint32_t>(*file, checkpoint_engine_offset(header.num_nodes)) !=
+        static_cast<std::uint32_t>(engine))
+    {
+        throw std::runtime_error("The checkpoint was written by another engine.");
+    }
+    return file;
+}
+} // namespace
+
+Engine parse_engine(const std::string &name)
+{
+    if (name == "edmonds")
+    {
+        return Engine::edmonds;
+    }
+    if (name == "phases")
+    {
+        return Engine::phases;
+    }
+    throw std::runtime_error("Unknown engine " + name + ".");
+}
+
+Adjacency parse_adjacency(const std::string &name)
+{
+    if (name == "auto")
+    {
+        return Adjacency::automatic;
+    }
+    if (name == "lists")
     {
-        NodeId other = _mu[v];
+        return Adjacency::lists;
+    }
+    if (name == "bitsets")
+    {
+        return Adjacency::bitsets;
+    }
+    throw std::runtime_error("Unknown adjacency " + name + ".");
+}
 
-        if (other < v)
+Graph EdmondsMatching::get_matching(const Graph &g, const MatchingOptions &options, MatchingStatistics *stats)
+{
+    return matching_graph(get_mates(g, options, stats));
+}
+
+std::vector<NodeId> EdmondsMatching::get_mates(const Graph &g,
+                                               const MatchingOptions &options,
+                                               MatchingStatistics *stats)
+{
+    if (!options.checkpoint.empty() || !options.resume.empty())
+    {
+        // The state of a single search on g is stored, so neither the graph nor the search may be split.
+        if (options.kernelize || options.warm_start != nullptr || options.order != DIMACS::NodeOrder::none ||
+            DIMACS::resolve_thread_count(options.num_threads) > 1)
         {
-            g.add_edge(v, other);
+            throw std::runtime_error("Checkpoints need one thread, no kernelization, no warm start and no renumbering.");
+        }
+        if (!options.resume.empty())
+        {
+            return solve_from(g, options, read_checkpoint_matching(g, options.resume, options.engine), stats);
         }
     }
-    return g;
+
+    if (options.warm_start != nullptr)
+    {
+        size_type dropped = 0;
+        std::vector<NodeId> mu = warm_start_matching(g, *options.warm_start, dropped);
+        // Nodes of dropped edges often have exposed neighbors.
+        extend_greedily(g, mu);
+        std::vector<NodeId> mate = DIMACS::resolve_thread_count(options.num_threads) > 1
+                                       ? get_mates_by_component(g, options, stats, &mu)
+                                       : solve_from(g, options, std::move(mu), stats);
+        if (stats != nullptr)
+        {
+            stats->warm_start_dropped = dropped;
+        }
+        return mate;
+    }
+
+    if (options.kernelize)
+    {
+        Kernelization reduction(g);
+        MatchingOptions kernel_options = options;
+        kernel_options.kernelize = false;
+        MatchingStatistics kernel_stats;
+        std::vector<NodeId> mate = reduction.lift(get_mates(reduction.kernel(), kernel_options, &kernel_stats));
+        if (stats != nullptr)
+        {
+            *stats = kernel_stats;
+            stats->reductions = reduction.statistics();
+            // Every matched node of degree one and every fold adds one edge.
+            size_type const reduced = stats->reductions.degree_one + stats->reductions.degree_two;
+            stats->initial_size += reduced;
+            stats->final_size += reduced;
+        }
+        return mate;
+    }
+
+    if (DIMACS::resolve_thread_count(options.num_threads) > 1)
+    {
+        return get_mates_by_component(g, options, stats, nullptr);
+    }
+
+    return solve_from(g, options, initial_matching(g, options.initialization), stats);
 }
 
-bool EdmondsMatching::forest_edge(NodeId v, NodeId u) const
+std::vector<NodeId> EdmondsMatching::solve_from(const Graph &g,
+                                                const MatchingOptions &options,
+                                                std::vector<NodeId> mu,
+                                                MatchingStatistics *stats)
+{
+    if (options.order != DIMACS::NodeOrder::none)
+    {
+        NodeRenumbering renumbering(g, options.order);
+        MatchingOptions renumbered = options;
+        renumbered.order = DIMACS::NodeOrder::none;
+        return renumbering.to_old(solve_from(renumbering.graph(), renumbered, renumbering.to_new(mu), stats));
+    }
+
+    // Bipartite graphs have no blossoms, so they are solved without the blossom machinery. The coloring usually fails
+    // after a few nodes on graphs with short odd cycles.
+    std::vector<unsigned char> side;
+    bool const checkpoints = !options.checkpoint.empty() || !options.resume.empty();
+    if (options.bipartite_fast_path && !checkpoints && two_coloring(g, side))
+    {
+        MatchingStatistics bipartite_stats;
+        bipartite_stats.bipartite = true;
+        bipartite_stats.initial_size = matching_size(mu);
+        bipartite_stats.phases = hopcroft_karp(g, side, mu);
+        bipartite_stats.final_size = matching_size(mu);
+        bipartite_stats.augmentations = bipartite_stats.final_size - bipartite_stats.initial_size;
+        if (stats != nullptr)
+        {
+            *stats = bipartite_stats;
+        }
+        return mu;
+    }
+
+    size_type const initial_size = matching_size(mu);
+    std::unique_ptr<BitsetAdjacency> dense;
+    if (options.adjacency == Adjacency::bitsets ||
+        (options.adjacency == Adjacency::automatic && BitsetAdjacency::suits(g, g.num_nodes() - 2 * initial_size)))
+    {
+        dense.reset(new BitsetAdjacency(g));
+    }
+
+    EdmondsMatching match(g, std::move(mu), options.engine, dense.get());
+    match._stats.initial_size = initial_size;
+    match._stats.bitsets = dense != nullptr;
+    match._options = &options;
+    if (!options.resume.empty())
+    {
+        match.restore_checkpoint(options.resume);
+    }
+    if (options.upper_bound)
+    {
+        // Isolated nodes are counted right away. The full bound costs about as much as a pass over the edges with
+        // the union-find structure, which only pays off for matchings close to perfect: it is computed once at most
+        // n / 64 nodes are exposed (see check_bound).
+        size_type isolated = 0;
+        for (NodeId v = 0; v < g.num_nodes(); ++v)
+        {
+            isolated += g.node(v).degree() == 0 ? 1 : 0;
+        }
+        match._size_bound = (g.num_nodes() - isolated) / 2;
+        match._bound_check = std::min<size_type>(match._size_bound, (g.num_nodes() - g.num_nodes() / 64) / 2);
+        match._bound_refined = false;
+    }
+
+    if (options.engine == Engine::phases)
+    {
+        match.run_phases();
+    }
+    else
+    {
+        match.run();
+    }
+    if (match._stats.interrupted && !options.checkpoint.empty())
+    {
+        match.write_checkpoint(options.checkpoint);
+    }
+
+    std::vector<NodeId> mate = match.mates();
+    if (stats != nullptr)
+    {
+        *stats = match._stats;
+        stats->final_size = matching_size(mate);
+    }
+    return mate;
+}
+
+std::vector<NodeId> EdmondsMatching::tutte_berge_set(const Graph &g, std::vector<NodeId> mate)
 {
-    return (u == _mu[v] || v == _phi[u] || u == _phi[v]);
+    EdmondsMatching match(g, std::move(mate), Engine::edmonds);
+    match.run();
+    if (match._stats.augmentations != 0)
+    {
+        throw std::runtime_error("Cannot certify a matching that is not maximum.");
+    }
+
+    std::vector<NodeId> set;
+    for (NodeId v = 0; v < g.num_nodes(); ++v)
+    {
+        if (match.get_type(v) == NodeType::inner)
+        {
+            set.push_back(v);
+        }
+    }
+    return set;
 }
 
-Path EdmondsMatching::get_path(NodeId v) const
+std::vector<NodeId> EdmondsMatching::get_mates_by_component(const Graph &g,
+                                                            const MatchingOptions &options,
+                                                            MatchingStatistics *stats,
+                                                            const std::vector<NodeId> *start)
 {
-    assert(get_type(v) == NodeType::outer);
+    ComponentSplit split(g, options.num_threads);
+    MatchingOptions sequential = options;
+    sequential.num_threads = 1;
+    sequential.warm_start = nullptr;
+    if (split.num_components() == 1)
+    {
+        return start != nullptr ? solve_from(g, sequential, *start, stats) : get_mates(g, sequential, stats);
+    }
 
-    Path path;
-    NodeId cur = v, last;
-    bool use_mu = true;
-    do
+    // Isolated nodes stay exposed and single edges are matched right away, everything else is solved by the worker
+    // threads, largest component first.
+    std::vector<NodeId> mate(g.num_nodes());
+    std::vector<size_type> order;
+    size_type single_edges = 0;
+    for (size_type c = 0; c < split.num_components(); ++c)
     {
-        assert(path.size() <= _g.num_nodes());
-        path.push_back(cur);
-        last = cur;
-        if (use_mu)
+        NodeIdRange nodes = split.nodes(c);
+        if (nodes.size() == 1)
         {
-            cur = _mu[last];
+            mate[nodes[0]] = nodes[0];
+        }
+        else if (nodes.size() == 2)
+        {
+            mate[nodes[0]] = nodes[1];
+            mate[nodes[1]] = nodes[0];
+            ++single_edges;
         }
         else
         {
-            cur = _phi[last];
+            order.push_back(c);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&split](size_type a, size_type b) {
+        return split.nodes(a).size() > split.nodes(b).size();
+    });
+
+    unsigned const num_tasks = static_cast<unsigned>(
+        std::max<size_type>(1, std::min<size_type>(DIMACS::resolve_thread_count(options.num_threads), order.size())));
+    std::vector<MatchingStatistics> task_stats(num_tasks);
+    std::vector<unsigned char> task_bipartite(num_tasks, true);
+    std::atomic<size_type> next(0);
+    DIMACS::run_parallel(num_tasks, [&](unsigned task) {
+        for (size_type i = next++; i < order.size(); i = next++)
+        {
+            NodeIdRange nodes = split.nodes(order[i]);
+            MatchingStatistics component_stats;
+            std::vector<NodeId> local;
+            if (start != nullptr)
+            {
+                // Matching edges never leave a component.
+                local.resize(nodes.size());
+                for (NodeId v = 0; v < nodes.size(); ++v)
+                {
+                    local[v] = split.local_id((*start)[nodes[v]]);
+                }
+                local = solve_from(split.subgraph(order[i]), sequential, std::move(local), &component_stats);
+            }
+            else
+            {
+                local = get_mates(split.subgraph(order[i]), sequential, &component_stats);
+            }
+            // Every component writes only the mates of its own nodes.
+            for (NodeId v = 0; v < nodes.size(); ++v)
+            {
+                mate[nodes[v]] = nodes[local[v]];
+            }
+            add_statistics(task_stats[task], component_stats);
+            task_bipartite[task] = task_bipartite[task] && component_stats.bipartite;
         }
-        use_mu = !use_mu;
-    } while (cur != last);
+    });
 
-    return path;
+    if (stats != nullptr)
+    {
+        *stats = MatchingStatistics();
+        stats->initial_size = stats->final_size = single_edges;
+        stats->components = split.num_components();
+        stats->bipartite = !order.empty();
+        for (unsigned task = 0; task < num_tasks; ++task)
+        {
+            add_statistics(*stats, task_stats[task]);
+            stats->bipartite = stats->bipartite && task_bipartite[task];
+        }
+    }
+    return mate;
 }
 
-NodeId EdmondsMatching::get_intersection(Path x_path, Path y_path) const
+void EdmondsMatching::add_statistics(MatchingStatistics &total, const MatchingStatistics &part)
 {
-    std::vector<bool> visited(_g.num_nodes(), false);
-    for (auto node : x_path)
+    total.initial_size += part.initial_size;
+    total.final_size += part.final_size;
+    total.scans += part.scans;
+    total.shrinks += part.shrinks;
+    total.augmentations += part.augmentations;
+    total.reset_nodes += part.reset_nodes;
+    total.phases = std::max(total.phases, part.phases);
+    total.bitsets = total.bitsets || part.bitsets;
+    total.interrupted = total.interrupted || part.interrupted;
+    total.checkpoints += part.checkpoints;
+    total.bound_stops += part.bound_stops;
+}
+
+void EdmondsMatching::reset_forest()
+{
+    _outer_queue.clear();
+    if (_dense != nullptr)
     {
-        visited[node] = true;
+        _forest_bits.clear();
+        _inner_bits.clear();
+        _scanned_bits.clear();
+        _frozen_bits.clear();
     }
-    for (auto node : y_path)
+    for (NodeId v = 0; v < _g.num_nodes(); ++v)
     {
-        if (visited[node])
+        reset_node(v);
+        _state[v].flags = 0;
+        // Exactly the exposed nodes are outer.
+        if (_state[v].mu == v)
         {
-            return node;
+            _outer_queue.push_back(v);
+            if (_dense != nullptr)
+            {
+                _forest_bits.set(v);
+            }
         }
     }
+}
 
-    return invalid_node_id;
+std::vector<NodeId> EdmondsMatching::mates() const
+{
+    std::vector<NodeId> mate(_g.num_nodes());
+    for (NodeId v = 0; v < _g.num_nodes(); ++v)
+    {
+        mate[v] = _state[v].mu;
+    }
+    return mate;
 }
 
-void EdmondsMatching::augment(NodeId x, NodeId y, Path x_path, Path y_path)
+bool EdmondsMatching::forest_edge(NodeId v, NodeId u) const
 {
-    // We only need to reset this connected component of the forest afterwards. But we need to safe it before the
-    // matching edges are updated, since this changes the connected component.
-    std::vector<int> visited(_g.num_nodes(), false);
-    std::vector<NodeId> stack;
-    stack.push_back(x);
-    while (!stack.empty())
+    return (u == _state[v].mu || v == _state[u].phi || u == _state[v].phi);
+}
+
+NodeId EdmondsMatching::find_common_blossom(NodeId x, NodeId y)
+{
+    _x_path.assign(1, x);
+    _y_path.assign(1, y);
+    _x_marks.clear();
+    _y_marks.clear();
+
+    // Looks at the last node of path: If its blossom has been passed by the other path, returns its base. Otherwise
+    // marks the blossom and appends the next node (alternately via mu and phi) unless the root is reached.
+    auto step = [this](Path &path, NodeMarker &own, const NodeMarker &other, bool &at_root) {
+        assert(path.size() <= _g.num_nodes());
+        NodeId cur = path.back();
+        NodeId base = rho(cur);
+        if (other.is_marked(base))
+        {
+            return base;
+        }
+        own.mark(base);
+
+        NodeId next = (path.size() % 2 == 1) ? _state[cur].mu : _state[cur].phi;
+        if (next == cur)
+        {
+            at_root = true;
+        }
+        else
+        {
+            path.push_back(next);
+        }
+        return invalid_node_id;
+    };
+
+    // The walk that was first has already passed the common blossom and has to be cut back to its first node in it.
+    auto cut_at_blossom = [this](Path &path, NodeId root) {
+        size_t i = 0;
+        while (rho(path[i]) != root)
+        {
+            ++i;
+        }
+        path.resize(i + 1);
+    };
+
+    bool x_at_root = false, y_at_root = false;
+    while (!x_at_root || !y_at_root)
     {
-        NodeId cur = stack.back();
-        stack.pop_back();
-        visited[cur] = true;
+        NodeId root;
+        if (!x_at_root && (root = step(_x_path, _x_marks, _y_marks, x_at_root)) != invalid_node_id)
+        {
+            cut_at_blossom(_y_path, root);
+            return root;
+        }
+        if (!y_at_root && (root = step(_y_path, _y_marks, _x_marks, y_at_root)) != invalid_node_id)
+        {
+            cut_at_blossom(_x_path, root);
+            return root;
+        }
+    }
+
+    return invalid_node_id;
+}
 
-        for (auto v : _g.node(cur).neighbors())
+void EdmondsMatching::augment(NodeId x, NodeId y, const Path &x_path, const Path &y_path)
+{
+    // We only need to reset the two trees of the forest containing x and y afterwards, all other trees stay valid. But
+    // we need to save them before the matching edges are updated, since this changes the trees. The list of collected
+    // nodes doubles as the work list of the search.
+    ++_stats.augmentations;
+    _x_marks.clear();
+    _tree_nodes.clear();
+    _tree_nodes.push_back(x);
+    _tree_nodes.push_back(y);
+    _x_marks.mark(x);
+    _x_marks.mark(y);
+    for (size_t i = 0; i < _tree_nodes.size(); ++i)
+    {
+        NodeId cur = _tree_nodes[i];
+        auto collect = [this, cur](NodeId v) {
+            if (!_x_marks.is_marked(v) && forest_edge(cur, v))
+            {
+                _x_marks.mark(v);
+                _tree_nodes.push_back(v);
+            }
+        };
+        if (_dense != nullptr)
+        {
+            // Forest edges only lead to nodes of the forest.
+            const Word *row = _dense->row(cur);
+            for (size_type w = 0; w < _dense->num_words(); ++w)
+            {
+                for_each_bit(row[w] & _forest_bits.word(w), w, collect);
+            }
+        }
+        else
         {
-            if (!visited[v] && forest_edge(cur, v))
+            for (auto v : _g.node(cur).neighbors())
             {
-                stack.push_back(v);
+                collect(v);
             }
         }
     }
 
     // Extreme measures to avoid code duplication.
     auto func = [this](NodeId n) {
-        _mu[_phi[n]] = n;
-        _mu[n] = _phi[n];
+        NodeId phi = _state[n].phi;
+        _state[phi].mu = n;
+        _state[n].mu = phi;
         return true;
     };
 
     do_on_odd(x_path, func, invalid_node_id);
     do_on_odd(y_path, func, invalid_node_id);
 
-    _mu[x] = y;
-    _mu[y] = x;
+    _state[x].mu = y;
+    _state[y].mu = x;
+
+    if (_engine == Engine::phases)
+    {
+        // The trees leave the search until the next phase, which rebuilds the whole forest anyway. Only the types of
+        // their nodes depend on the changed mates.
+        for (auto i : _tree_nodes)
+        {
+            freeze(i);
+            update_type(i);
+        }
+        return;
+    }
+
+    // Now both trees are reset. All their nodes are matched now, so none of them is outer.
+    for (auto i : _tree_nodes)
+    {
+        reset_node(i);
+        set_scanned(i, false);
+        if (_dense != nullptr)
+        {
+            _forest_bits.reset(i);
+            _inner_bits.reset(i);
+        }
+    }
+    _stats.reset_nodes += _tree_nodes.size();
 
-    // Now the connected component is reseted.
-    for (NodeId i = 0; i < _g.num_nodes(); ++i)
+    // The reset nodes are out of the forest now. Scanned outer nodes of other trees next to them have to be scanned
+    // again, otherwise they would never grow their tree into them.
+    auto requeue = [this](NodeId v) {
+        if (has_flag(v, scanned_bit) && get_type(v) == NodeType::outer)
+        {
+            set_scanned(v, false);
+            _outer_queue.push_back(v);
+        }
+    };
+    if (_dense != nullptr)
+    {
+        // With bitsets, the neighborhood of all reset nodes is collected first and intersected with the scanned nodes.
+        std::fill(_row_union.begin(), _row_union.end(), 0);
+        for (auto i : _tree_nodes)
+        {
+            const Word *row = _dense->row(i);
+            for (size_type w = 0; w < _row_union.size(); ++w)
+            {
+                _row_union[w] |= row[w];
+            }
+        }
+        for (size_type w = 0; w < _row_union.size(); ++w)
+        {
+            for_each_bit(_row_union[w] & _scanned_bits.word(w), w, requeue);
+        }
+        return;
+    }
+    for (auto i : _tree_nodes)
     {
-        if (visited[i])
+        for (auto v : _g.node(i).neighbors())
         {
-            _phi[i] = i;
-            _rho[i] = i;
-            scanned[i] = false;
+            requeue(v);
         }
     }
 }
 
-void EdmondsMatching::shrink(NodeId x, NodeId y, NodeId intersection, Path x_path, Path y_path)
+void EdmondsMatching::shrink(NodeId x, NodeId y, NodeId root, const Path &x_path, const Path &y_path)
 {
-    assert(intersection != invalid_node_id);
-
-    // This is the first root of a blossom on both paths.
-    NodeId root = _rho[intersection];
+    assert(root != invalid_node_id);
     assert(get_type(root) == NodeType::outer);
+    ++_stats.shrinks;
+
     // On does not simply duplicate code.
     auto func = [this, root](NodeId n) {
-        if (_rho[_phi[n]] == root)
+        NodeId phi = _state[n].phi;
+        if (rho(phi) == root)
         {
             return true;
         }
@@ -139,116 +589,339 @@ void EdmondsMatching::shrink(NodeId x, NodeId y, NodeId intersection, Path x_pat
         {
             return false;
         }
-        _phi[_phi[n]] = n;
+        _state[phi].phi = n;
         return true;
     };
 
-    // Once to the root the other time just to the intersection, otherwise we would change some nodes twice.
-    do_on_odd(x_path, func, root);
-    do_on_odd(y_path, func, intersection);
+    // Both paths stop at their first node in the blossom of root, the rest of the way to root lies inside of it and
+    // would not be changed anyway.
+    do_on_odd(x_path, func, x_path.back());
+    do_on_odd(y_path, func, y_path.back());
 
-    if (_rho[x] != root)
+    if (rho(x) != root)
     {
-        _phi[x] = y;
+        _state[x].phi = y;
     }
-    if (_rho[y] != root)
+    if (rho(y) != root)
     {
-        _phi[y] = x;
+        _state[y].phi = x;
     }
 
-    std::vector<int> on_path(_g.num_nodes(), false);
-    auto mark_path_nodes = [&on_path, this](Path &p, NodeId abort) {
-        for (auto i : p)
+    // The nodes on both paths join the blossom, so the inner ones are outer now. No other node changes its type.
+    for (const Path *p : {&x_path, &y_path})
+    {
+        for (auto i : *p)
         {
-            if (i == abort)
+            _state[i].type = NodeType::outer;
+        }
+    }
+    queue_path(x_path, x_path.back());
+    queue_path(y_path, y_path.back());
+    if (_dense != nullptr)
+    {
+        for (const Path *p : {&x_path, &y_path})
+        {
+            for (auto i : *p)
             {
-                return;
+                if (_inner_bits.test(i) && get_type(i) != NodeType::inner)
+                {
+                    _inner_bits.reset(i);
+                }
             }
-            on_path[i] = true;
+        }
+    }
+
+    // Now all blossoms intersecting both paths are merged into one blossom with base root. Every such blossom contains
+    // a node of the paths, so merging the sets of the path nodes suffices and costs time proportional to the paths.
+    auto merge_path_nodes = [this, root](const Path &p) {
+        for (auto i : p)
+        {
+            merge_blossom(i, root);
         }
     };
 
-    // It would not be bad to mark nodes twice but it is also not necessary.
-    mark_path_nodes(x_path, root);
-    mark_path_nodes(y_path, intersection);
+    merge_path_nodes(x_path);
+    merge_path_nodes(y_path);
+}
 
-    // Now all blossoms intersection both paths belong to a blossom rooted at root.
-    for (NodeId i = 0; i < _g.num_nodes(); ++i)
+void EdmondsMatching::scan_node(NodeId node)
+{
+    ++_stats.scans;
+
+    if (_dense != nullptr)
     {
-        if (on_path[_rho[i]])
+        // Inner and frozen neighbors are skipped without looking at them.
+        const Word *row = _dense->row(node);
+        for (size_type w = 0; w < _dense->num_words(); ++w)
         {
-            _rho[i] = root;
+            Word candidates = row[w] & ~_inner_bits.word(w) & ~_frozen_bits.word(w);
+            while (candidates != 0)
+            {
+                NodeId neighbor = w * word_bits + __builtin_ctzll(candidates);
+                candidates &= candidates - 1;
+                if (!scan_edge(node, neighbor))
+                {
+                    return;
+                }
+            }
         }
     }
+    else
+    {
+        for (auto neighbor : _g.node(node).neighbors())
+        {
+            if (!scan_edge(node, neighbor))
+            {
+                return;
+            }
+        }
+    }
+    set_scanned(node, true);
 }
 
-void EdmondsMatching::scan_node(NodeId node)
+bool EdmondsMatching::scan_edge(NodeId node, NodeId neighbor)
 {
-    const Node &n = _g.node(node);
+    if (has_flag(neighbor, frozen_bit))
+    {
+        return true;
+    }
+    NodeType type = get_type(neighbor);
+
+    if (type == NodeType::out_of_forrest)
+    {
+        // Grow step: the neighbor becomes inner, its mate outer.
+        NodeId mate = _state[neighbor].mu;
+        _state[neighbor].phi = node;
+        _state[neighbor].type = NodeType::inner;
+        _state[mate].type = NodeType::outer;
+        if (_dense != nullptr)
+        {
+            _forest_bits.set(neighbor);
+            _forest_bits.set(mate);
+            _inner_bits.set(neighbor);
+        }
+        queue_if_unscanned_outer(mate);
+
+        return true;
+    }
+    if (!(type == NodeType::outer && rho(node) != rho(neighbor)))
+    {
+        return true;
+    }
+
+    NodeId root = find_common_blossom(node, neighbor);
 
-    for (auto neighbor : n.neighbors())
+    if (root == invalid_node_id)
     {
-        NodeType type = get_type(neighbor);
+        // So the paths are vertex disjoint, we can augment the matching.
+        augment(node, neighbor, _x_path, _y_path);
 
-        if (type == NodeType::out_of_forrest)
+        return false;
+    }
+
+    // The paths are not vertex disjoint, so we put them in the same blossom and shrink it.
+    shrink(node, neighbor, root, _x_path, _y_path);
+    return true;
+}
+
+void EdmondsMatching::queue_path(const Path &p, NodeId stop)
+{
+    for (auto node : p)
+    {
+        if (node == stop)
         {
-            // Grow step
-            _phi[neighbor] = node;
+            return;
+        }
+        queue_if_unscanned_outer(node);
+    }
+}
 
-            continue;
+void EdmondsMatching::run()
+{
+    while (!_outer_queue.empty())
+    {
+        if (current_size() >= _bound_check && check_bound())
+        {
+            // The matching is maximum, scanning the remaining outer nodes could only prove it.
+            _stats.bound_stops = 1;
+            return;
         }
-        if (!(type == NodeType::outer && _rho[node] != _rho[neighbor]))
+        if (_options != nullptr && poll())
         {
-            continue;
+            _stats.interrupted = true;
+            return;
         }
+        NodeId x = _outer_queue.front();
+        _outer_queue.pop_front();
 
-        auto x_path = get_path(node);
-        auto y_path = get_path(neighbor);
-
-        auto intersection = get_intersection(x_path, y_path);
-
-        if (intersection == invalid_node_id)
+        // Nodes are queued when they become outer, but they may have been scanned, reset or frozen since.
+        if (get_type(x) == NodeType::outer && !has_flag(x, scanned_bit | frozen_bit))
         {
-            // So the paths are vertex disjoint, we can augment the matching.
-            augment(node, neighbor, x_path, y_path);
+            scan_node(x);
+        }
+    }
+}
 
+void EdmondsMatching::run_phases()
+{
+    while (true)
+    {
+        ++_stats.phases;
+        size_type const augmentations = _stats.augmentations;
+        run();
+        if ((_stats.augmentations == augmentations && !_resumed_phase_augmented) || _stats.interrupted ||
+            _stats.bound_stops != 0)
+        {
             return;
         }
+        _resumed_phase_augmented = false;
+        _stats.reset_nodes += _g.num_nodes();
+        reset_forest();
+    }
+}
 
-        else
+bool EdmondsMatching::check_bound()
+{
+    // A perfect matching of the non-isolated nodes needs no refinement. Otherwise the bound costs about as much as
+    // scanning every node once, so the search first does a share of that work itself: an almost perfect initial
+    // matching is often completed by a few scans. Until then, this is called again before every scan.
+    if (!_bound_refined && current_size() < _size_bound)
+    {
+        if (_stats.scans < _g.num_nodes() / 4)
         {
-            // The paths are not vertex disjoint, so we put them in the same blossom and shrink it.
-            shrink(node, neighbor, intersection, x_path, y_path);
+            return false;
         }
+        _size_bound = std::min(_size_bound, matching_upper_bound(_g).value);
+        _bound_refined = true;
     }
-    scanned[node] = true;
+    _bound_check = _size_bound;
+    return current_size() >= _size_bound;
 }
 
-void EdmondsMatching::run()
+bool EdmondsMatching::poll()
 {
-    while (true)
+    if (_options->checkpoint_request != nullptr && _options->checkpoint_request->load() &&
+        _options->checkpoint_request->exchange(false))
     {
-        auto x = invalid_node_id;
+        write_checkpoint(_options->checkpoint);
+    }
+    if (_options->stop != nullptr && _options->stop->load())
+    {
+        return true;
+    }
+    // Reading the clock costs about as much as a short scan.
+    return ++_polls % 64 == 0 && std::chrono::steady_clock::now() >= _options->deadline;
+}
+
+void EdmondsMatching::write_checkpoint(const std::string &filename)
+{
+    NodeId const n = _g.num_nodes();
+    std::vector<NodeId> phi(n);
+    std::vector<NodeId> mu(n);
+    std::vector<NodeId> rho_of(n);
+    std::vector<unsigned char> flags(n, 0);
+    for (NodeId v = 0; v < n; ++v)
+    {
+        phi[v] = _state[v].phi;
+        mu[v] = _state[v].mu;
+        rho_of[v] = rho(v);
+        flags[v] = (has_flag(v, scanned_bit) ? scanned_flag : 0) | (has_flag(v, frozen_bit) ? frozen_flag : 0);
+    }
+
+    std::uint32_t const engine = static_cast<std::uint32_t>(_engine);
+
+    auto header = DIMACS::make_header(
+        DIMACS::BinaryKind::checkpoint, sizeof(NodeId), 0, n, _g.num_edges(), DIMACS::SourceStamp());
+    DIMACS::write_binary(filename,
+                         header,
+                         {{phi.data(), n * sizeof(NodeId)},
+                          {mu.data(), n * sizeof(NodeId)},
+                          {rho_of.data(), n * sizeof(NodeId)},
+                          {flags.data(), n},
+                          {&engine, sizeof(engine)}});
+    ++_stats.checkpoints;
+}
+
+std::vector<NodeId>
+EdmondsMatching::read_checkpoint_matching(const Graph &g, const std::string &filename, Engine engine)
+{
+    auto file = map_checkpoint(g, filename, engine);
+    NodeId const n = g.num_nodes();
+    const NodeId *mu = DIMACS::binary_array<NodeId>(*file, DIMACS::aligned_size(n * sizeof(NodeId)));
 
-        for (NodeId i = 0; i < _g.num_nodes(); i++)
+    std::vector<NodeId> mate(mu, mu + n);
+    for (NodeId v = 0; v < n; ++v)
+    {
+        bool valid = mate[v] < n && mate[mate[v]] == v;
+        if (valid && mate[v] != v)
         {
-            if (get_type(i) == NodeType::outer && !scanned[i])
+            NodeIdRange neighbors = g.node(v).neighbors();
+            valid = std::find(neighbors.begin(), neighbors.end(), mate[v]) != neighbors.end();
+        }
+        if (!valid)
+        {
+            throw std::runtime_error("The checkpoint does not contain a matching of the graph.");
+        }
+    }
+    return mate;
+}
+
+void EdmondsMatching::restore_checkpoint(const std::string &filename)
+{
+    auto file = map_checkpoint(_g, filename, _engine);
+    NodeId const n = _g.num_nodes();
+    std::size_t const array_size = DIMACS::aligned_size(n * sizeof(NodeId));
+    const NodeId *phi = DIMACS::binary_array<NodeId>(*file, 0);
+    const NodeId *mu = DIMACS::binary_array<NodeId>(*file, array_size);
+    const NodeId *rho_of = DIMACS::binary_array<NodeId>(*file, 2 * array_size);
+    const unsigned char *flags = DIMACS::binary_array<unsigned char>(*file, 3 * array_size);
+
+    reset_forest();
+    _outer_queue.clear();
+    for (NodeId v = 0; v < n; ++v)
+    {
+        if (phi[v] >= n || rho_of[v] >= n || mu[v] != _state[v].mu)
+        {
+            throw std::runtime_error("The checkpoint is damaged.");
+        }
+        _state[v].phi = phi[v];
+        if (rho_of[v] != v)
+        {
+            merge_blossom(v, rho_of[v]);
+        }
+    }
+
+    for (NodeId v = 0; v < n; ++v)
+    {
+        update_type(v);
+        set_scanned(v, (flags[v] & scanned_flag) != 0);
+        if ((flags[v] & frozen_flag) != 0)
+        {
+            // Only the trees of augmenting paths are frozen.
+            freeze(v);
+            _resumed_phase_augmented = true;
+        }
+        NodeType const type = get_type(v);
+        if (_dense != nullptr)
+        {
+            if (type != NodeType::out_of_forrest)
             {
-                x = i;
-                break;
+                _forest_bits.set(v);
+            }
+            if (type == NodeType::inner)
+            {
+                _inner_bits.set(v);
             }
         }
-
-        if (x == invalid_node_id)
+        if (type == NodeType::outer && !has_flag(v, scanned_bit | frozen_bit))
         {
-            break;
+            _outer_queue.push_back(v);
         }
-        scan_node(x);
     }
 }
 
 template <typename func>
-void EdmondsMatching::do_on_odd(Path &p, func f, NodeId stop)
+void EdmondsMatching::do_on_odd(const Path &p, func f, NodeId stop)
 {
     bool go_on = true;
     for (size_t i = 1; i < p.size() && go_on; i += 2)
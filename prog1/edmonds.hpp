@@ -1,8 +1,23 @@
 #ifndef EDMONDS_HPP
 #define EDMONDS_HPP
 
+#include "bipartite.hpp"
+#include "bitset_adjacency.hpp"
+#include "bounds.hpp"
 #include "graph.hpp"
+#include "initial_matching.hpp"
+#include "kernel.hpp"
+#include "node_marker.hpp"
+#include "renumbering.hpp"
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <iostream>
 
 /**
@@ -18,18 +33,124 @@ using Path = std::vector<NodeId>;
 /**
      * We will partition the nodes into these three types.
      */
-enum class NodeType
+enum class NodeType : unsigned char
 {
     outer,
     inner,
     out_of_forrest
 };
 
+/**
+     * The ways @c EdmondsMatching can organize its search.
+     */
+enum class Engine
+{
+    //! One forest for the whole run, after an augmentation only the two trees of the augmenting path are rebuilt.
+    edmonds,
+    //! In phases: the forest is grown breadth-first from all exposed nodes, every augmenting path found freezes its
+    //! two trees for the rest of the phase. The next phase starts from an empty forest. The run ends after a phase
+    //! without augmentation. A heuristic schedule: the paths need not be shortest, so unlike Hopcroft-Karp there is no
+    //! bound on the number of phases beyond the number of augmentations.
+    phases
+};
+
+/**
+     * @return The engine named @c name (one of "edmonds", "phases"). Throws if there is no such engine.
+     */
+Engine parse_engine(const std::string &name);
+
+/**
+     * How @c EdmondsMatching finds the neighbors of a node.
+     */
+enum class Adjacency
+{
+    //! Bitsets if @c BitsetAdjacency::suits the graph, otherwise lists.
+    automatic,
+    //! The neighbor lists of the @c Graph.
+    lists,
+    //! A @c BitsetAdjacency, combined with bitsets of the node states, so that e.g. the inner neighbors of a scanned
+    //! node are skipped 64 at a time.
+    bitsets
+};
+
+/**
+     * @return The adjacency named @c name (one of "auto", "lists", "bitsets"). Throws if there is no such adjacency.
+     */
+Adjacency parse_adjacency(const std::string &name);
+
+/**
+     * Options for @c EdmondsMatching::get_matching.
+     */
+struct MatchingOptions
+{
+    //! How the matching the algorithm starts from is computed.
+    Initialization initialization = Initialization::empty;
+    //! How the search is organized.
+    Engine engine = Engine::edmonds;
+    //! How the engine finds the neighbors of a node.
+    Adjacency adjacency = Adjacency::automatic;
+    //! If the graph is bipartite, the matching is computed by @c hopcroft_karp instead of the engine. Off by default
+    //! because the engines need no blossoms on bipartite graphs and were faster on every instance we measured.
+    bool bipartite_fast_path = false;
+    //! Whether the graph is reduced by @c Kernelization first.
+    bool kernelize = false;
+    //! The order in which the nodes are renumbered before the search (see @c NodeRenumbering), the mates are mapped
+    //! back afterwards. With components or a kernel, every part is renumbered on its own. Not combinable with
+    //! checkpoints.
+    DIMACS::NodeOrder order = DIMACS::NodeOrder::none;
+    //! With more than one thread (0 meaning one per hardware thread), the connected components are solved
+    //! separately and concurrently.
+    unsigned num_threads = 1;
+    //! If not null, a matching (e.g. one of an earlier version of the graph, see @c read_matching) to start from
+    //! instead of @c initialization. Its edges that do not fit the graph are dropped (see @c warm_start_matching),
+    //! then it is extended greedily. The reductions of @c kernelize are not applied, they would replace most of it.
+    const Graph *warm_start = nullptr;
+    //! Whether the search stops as soon as the matching reaches @c matching_upper_bound, i.e. is provably maximum.
+    bool upper_bound = true;
+    //! The search stops at this time and returns the matching found so far, which need not be maximum. Not checked by
+    //! @c hopcroft_karp.
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    //! If not null, the search stops as soon as this is true, as at the deadline (e.g. set on SIGTERM).
+    const std::atomic<bool> *stop = nullptr;
+    //! If not empty, the state of the search is written to this file when it stops early, and whenever
+    //! @c checkpoint_request is true (which is reset then). Needs one thread, no kernelization, no warm start and no
+    //! renumbering.
+    std::string checkpoint;
+    std::atomic<bool> *checkpoint_request = nullptr;
+    //! If not empty, the search continues from the state in this checkpoint file (of the same graph, written with the
+    //! same @c engine) instead of starting from @c initialization. Has the same restrictions as @c checkpoint.
+    std::string resume;
+};
+
+/**
+     * Statistics about a run of @c EdmondsMatching::get_matching.
+     */
+struct MatchingStatistics
+{
+    size_type initial_size = 0;  //!< Number of edges of the initial matching.
+    size_type final_size = 0;    //!< Number of edges of the maximum matching.
+    size_type scans = 0;         //!< Number of calls of @c scan_node.
+    size_type shrinks = 0;       //!< Number of blossoms shrunk.
+    size_type augmentations = 0; //!< Number of augmenting paths found.
+    size_type reset_nodes = 0;   //!< Total number of nodes reset after augmentations or phases.
+    size_type phases = 0;        //!< Number of phases (of @c Engine::phases or @c hopcroft_karp, maximum over components).
+    size_type components = 0;    //!< Number of connected components, if they were solved separately.
+    bool bipartite = false;      //!< Whether the matching was computed by @c hopcroft_karp (in every component).
+    size_type warm_start_dropped = 0; //!< Number of edges of the warm start that did not fit the graph.
+    bool bitsets = false;        //!< Whether the engine used a @c BitsetAdjacency (in some component).
+    bool interrupted = false;    //!< Whether the search stopped early, so that the matching need not be maximum.
+    size_type checkpoints = 0;   //!< Number of checkpoints written.
+    size_type bound_stops = 0;   //!< Number of searches stopped because the matching reached the upper bound.
+    ReductionStatistics reductions; //!< What the @c Kernelization removed, if it was used.
+};
+
 /**
      * @class EdmondsMatching
      *
      * @brief This class implements the algorithm. For a given @c Graph g, we find a maximum matching in O(n^3) time,
-     * where n is the number of nodes in g.
+     * where n is the number of nodes in g. The search is organized by an @c Engine chosen in the @c MatchingOptions.
+     * @c Engine::phases only changes the order of the search: each of its at most n/2 + 1 phases grows one forest in
+     * O(n^2) time, so the bound is the same.
      */
 class EdmondsMatching
 {
@@ -38,52 +159,159 @@ class EdmondsMatching
     /**
          * Runs the algorithm on the given graph.
          * @param g @c Graph in which to find the maximum matching.
+         * @param options Chooses e.g. the initial matching.
+         * @param stats If not null, receives statistics about the run.
          * @return A @c Graph on the same set of \c Nodes containing exactly the edges of a maximum matching.
          */
-    static Graph get_matching(const Graph &g);
+    static Graph get_matching(const Graph &g,
+                              const MatchingOptions &options = MatchingOptions(),
+                              MatchingStatistics *stats = nullptr);
+
+    /**
+         * Like @c get_matching, but returns the maximum matching as a mate array (see initial_matching.hpp).
+         */
+    static std::vector<NodeId> get_mates(const Graph &g,
+                                         const MatchingOptions &options = MatchingOptions(),
+                                         MatchingStatistics *stats = nullptr);
+
+    /**
+         * Grows the forest of Edmonds' algorithm from the exposed nodes of the maximum matching @c mate of @c g, which
+         * costs one search without augmentations. Its inner nodes form the set @c A of the Gallai–Edmonds
+         * decomposition, for which the matching attains the Tutte–Berge bound (see certificate.hpp).
+         * @return The inner nodes in increasing order. Throws if the matching is not maximum.
+         */
+    static std::vector<NodeId> tutte_berge_set(const Graph &g, std::vector<NodeId> mate);
 
   private:
     /**
-         * Initializes the data for the given @c Graph @c g.
+         * Implements @c get_mates for more than one thread: splits @c g into its connected components, solves them on
+         * the threads (largest first, each thread taking the next component when it is done) and merges the results.
+         * If @c start is not null, every component starts from its part of this mate array.
+         */
+    static std::vector<NodeId> get_mates_by_component(const Graph &g,
+                                                      const MatchingOptions &options,
+                                                      MatchingStatistics *stats,
+                                                      const std::vector<NodeId> *start);
+
+    /**
+         * Computes a maximum matching of @c g starting from the matching given by the mate array @c mu, by
+         * @c hopcroft_karp or by the engine of @c options.
+         */
+    static std::vector<NodeId> solve_from(const Graph &g,
+                                          const MatchingOptions &options,
+                                          std::vector<NodeId> mu,
+                                          MatchingStatistics *stats);
+
+    /**
+         * Adds the counters of @c part to @c total.
          */
-    explicit EdmondsMatching(const Graph &g) : _g(g),
-                                               _phi(_g.num_nodes()),
-                                               _mu(_g.num_nodes()),
-                                               _rho(_g.num_nodes()),
-                                               scanned(_g.num_nodes(), false)
+    static void add_statistics(MatchingStatistics &total, const MatchingStatistics &part);
+
+    /**
+         * Initializes the data for the given @c Graph @c g, starting from the matching given by the mate array
+         * @c mu (see initial_matching.hpp) and an empty forest.
+         * @param dense If not null, the adjacency matrix of @c g, which is then used instead of the neighbor lists.
+         */
+    EdmondsMatching(const Graph &g, std::vector<NodeId> mu, Engine engine, const BitsetAdjacency *dense = nullptr)
+        : _g(g),
+          _engine(engine),
+          _state(_g.num_nodes()),
+          _base(_g.num_nodes()),
+          _x_marks(_g.num_nodes()),
+          _y_marks(_g.num_nodes()),
+          _dense(dense),
+          _forest_bits(dense != nullptr ? _g.num_nodes() : 0),
+          _inner_bits(dense != nullptr ? _g.num_nodes() : 0),
+          _scanned_bits(dense != nullptr ? _g.num_nodes() : 0),
+          _frozen_bits(dense != nullptr ? _g.num_nodes() : 0),
+          _row_union(dense != nullptr ? dense->num_words() : 0),
+          _options(nullptr),
+          _polls(0),
+          _resumed_phase_augmented(false),
+          _size_bound(invalid_node_id),
+          _bound_check(invalid_node_id),
+          _bound_refined(true)
     {
+        assert(mu.size() == _g.num_nodes());
+        if (_g.num_nodes() > max_state_nodes)
+        {
+            throw std::runtime_error("The graph has too many nodes for 32-bit node states.");
+        }
         for (NodeId v = 0; v < _g.num_nodes(); ++v)
         {
-            _phi[v] = v;
-            _mu[v] = v;
-            _rho[v] = v;
+            _state[v].mu = mu[v];
         }
+        reset_forest();
     }
 
     /**
-         * @return The current state of the matching.
+         * Makes the forest empty, i.e. every exposed node is the root of a tree consisting only of itself, and queues
+         * the exposed nodes. Takes O(n) time.
          */
-    Graph populate() const;
+    void reset_forest();
 
     /**
-         * @return The type of the @c Node with @c NodeId @c n.
+         * @return The type of the @c Node with @c NodeId @c n, as cached in its state.
          */
     NodeType get_type(NodeId node) const;
 
     /**
-         * @return True, if the edge between @c v and @c u is in the special blossom forest, false otherwise.
+         * @return The type of @c node as defined by phi and mu: outer if it is exposed or the phi of its mate is not
+         * the mate itself, otherwise inner if its own phi is not itself, otherwise out of the forest.
          */
-    bool forest_edge(NodeId v, NodeId u) const;
+    NodeType derive_type(NodeId node) const;
+
+    /**
+         * Sets the cached type of @c node to @c derive_type. Has to be called whenever the phi or mu of @c node or
+         * the phi of its mate changed.
+         */
+    void update_type(NodeId node);
+
+    /**
+         * @return Whether @c node has the given flag (@c scanned_bit or @c frozen_bit).
+         */
+    bool has_flag(NodeId node, unsigned char flag) const;
+
+    /**
+         * @return The base of the blossom containing @c node (rho in Korte and Vygen).
+         */
+    NodeId rho(NodeId node);
+
+    /**
+         * @return The representative of the blossom containing @c node, in the disjoint-set forest of the blossoms.
+         */
+    NodeId find_blossom(NodeId node);
+
+    /**
+         * Merges the blossom containing @c node into the one with base @c root, which stays the base.
+         */
+    void merge_blossom(NodeId node, NodeId root);
+
+    /**
+         * Makes @c node a blossom of its own and its own phi. Sets its type to the one it has once its mate is reset
+         * as well, its flags are kept.
+         * @warning Only valid if its whole blossom is reset, since other members may point to @c node.
+         */
+    void reset_node(NodeId node);
+
+    /**
+         * @return The matching as mate array.
+         */
+    std::vector<NodeId> mates() const;
 
     /**
-         * @return The M-alternating path from @c v to the root of its connected component.
+         * @return True, if the edge between @c v and @c u is in the special blossom forest, false otherwise.
          */
-    Path get_path(NodeId v) const;
+    bool forest_edge(NodeId v, NodeId u) const;
 
     /**
-         * @return The first node which lies on @c x_path and @c y_path.
+         * Walks the M-alternating paths from @c x and from @c y towards the roots of their connected components
+         * alternately, one node at a time, until one of them enters a blossom the other one has already passed.
+         * Afterwards @c _x_path and @c _y_path hold the walked paths: If such a common blossom exists, each path ends
+         * with its first node inside of it, otherwise both paths end at their roots.
+         * @return The base of the first common blossom of the two paths or @c invalid_node_id if there is none.
          */
-    NodeId get_intersection(Path x_path, Path y_path) const;
+    NodeId find_common_blossom(NodeId x, NodeId y);
 
     /**
          * Grows the blossom forest, augments the matching or shrinks blossoms.
@@ -91,29 +319,102 @@ class EdmondsMatching
          */
     void scan_node(NodeId node);
 
+    /**
+         * Handles the edge from the outer node @c node to @c neighbor for @c scan_node.
+         * @return False if the matching was augmented, which ends the scan.
+         */
+    bool scan_edge(NodeId node, NodeId neighbor);
+
+    /**
+         * Sets the @c scanned_bit of @c node, and its bit in @c _scanned_bits.
+         */
+    void set_scanned(NodeId node, bool value);
+
+    /**
+         * Sets the @c frozen_bit of @c node, and its bit in @c _frozen_bits.
+         */
+    void freeze(NodeId node);
+
     /**
          * Augments along the path from the root of the connected component of @c x through @c x and @c y to the root of
-         * the connected component of @c y.
+         * the connected component of @c y. Afterwards, the nodes of both components are removed from the forest, in
+         * time proportional to their number and degrees.
          * @param x_path, y_path The paths starting in @c x and @c y to the roots of their respective connected
          * components, need to be vertex disjoint.
          */
-    void augment(NodeId x, NodeId y, Path x_path, Path y_path);
+    void augment(NodeId x, NodeId y, const Path &x_path, const Path &y_path);
 
     /**
-         * Shrinks the blossom to which @c x, @c y and the @c intersection of the paths starting in @c x and @c y belong.
-         * @param intersection The first node lying on both @c x_path and @c y_path.
-         * @param x_path, y_path The paths starting in @c x and @c y to the roots of their respective connected
-         * components.
+         * Shrinks the blossom to which @c x, @c y and the first common blossom of the paths starting in @c x and @c y
+         * belong.
+         * @param root The base of the first common blossom.
+         * @param x_path, y_path The paths starting in @c x and @c y, each ending with its first node in the blossom of
+         * @c root (see @c find_common_blossom).
+         */
+    void shrink(NodeId x, NodeId y, NodeId root, const Path &x_path, const Path &y_path);
+
+    /**
+         * Queues @c node for scanning if it is an outer, unscanned node. Has to be called whenever a node might have
+         * become outer, i.e. when its mu or the phi of its mate changed.
          */
-    void shrink(NodeId x, NodeId y, NodeId intersection, Path x_path, Path y_path);
+    void queue_if_unscanned_outer(NodeId node);
 
     /**
-         * Starts the algorithm. Iterates over all nodes and scans them until no further improvement can be done.
+         * Queues all unscanned outer nodes on @c p, stopping before @c stop.
+         */
+    void queue_path(const Path &p, NodeId stop);
+
+    /**
+         * Starts the algorithm. Scans queued outer nodes until no further improvement can be done.
          * @warning The object has to be in a valid state (so encoding a valid matching and blossom forest) when this is
          * called. This is the case if it is called directly after calling the constructor.
          */
     void run();
 
+    /**
+         * Runs @c run in phases until a phase does not find an augmenting path (see @c Engine::phases).
+         */
+    void run_phases();
+
+    /**
+         * @return The number of edges of the matching.
+         */
+    size_type current_size() const;
+
+    /**
+         * Called once the matching has @c _bound_check edges: computes @c matching_upper_bound, unless this has been
+         * done or the search has scanned fewer than n / 4 nodes so far, and updates @c _size_bound and
+         * @c _bound_check.
+         * @return Whether the matching has reached @c _size_bound, so that it is maximum.
+         */
+    bool check_bound();
+
+    /**
+         * Called by @c run between two scans. Writes a checkpoint if one was requested. Looks at the clock only every
+         * 64 calls.
+         * @return Whether the search has to stop because of the deadline or the stop flag of @c _options.
+         */
+    bool poll();
+
+    /**
+         * Writes the matching, the forest (phi and @c rho), the scanned and frozen flags and the engine to
+         * @c filename, in the binary format of binary_graph.hpp. The file is replaced atomically, so an old
+         * checkpoint survives a crash.
+         */
+    void write_checkpoint(const std::string &filename);
+
+    /**
+         * Replaces the state by the one in the checkpoint @c filename, and queues all unscanned outer nodes (the
+         * order of the queue is not stored). Throws if the checkpoint does not belong to the graph and the engine.
+         */
+    void restore_checkpoint(const std::string &filename);
+
+    /**
+         * @return The matching stored in the checkpoint @c filename of @c g. Throws if the file is no checkpoint of
+         * @c g written by @c engine or the matching is none of @c g.
+         */
+    static std::vector<NodeId> read_checkpoint_matching(const Graph &g, const std::string &filename, Engine engine);
+
     /**
          * Helper method to call @c f on every second node of @c p.
          * @fparam func The type of @c f. Should be a function taking a @c NodeId and returning a true value while the
@@ -121,25 +422,100 @@ class EdmondsMatching
          * @param stop The method will stop when this @c Node is reached (even if it has even distance from the start).
          */
     template <typename func>
-    void do_on_odd(Path &p, func f, NodeId stop);
+    void do_on_odd(const Path &p, func f, NodeId stop);
+
+    //! Node ids in @c NodeState.
+    using StateId = std::uint32_t;
+    static constexpr size_type max_state_nodes = std::numeric_limits<StateId>::max();
+
+    //! Bits of @c NodeState::flags.
+    static constexpr unsigned char scanned_bit = 1;
+    static constexpr unsigned char frozen_bit = 2;
+
+    /**
+         * Everything a scan looks at for a neighbor, in 16 bytes, so that it costs one cache line instead of one per
+         * array. The blossoms (i.e. the sets of nodes with the same rho) form a disjoint-set forest with union by
+         * rank and path halving, whose links are stored here as well.
+         */
+    struct NodeState
+    {
+        StateId phi = 0;
+        StateId mu = 0;
+        StateId blossom = 0;                      //!< The parent in the forest of the blossoms.
+        NodeType type = NodeType::out_of_forrest; //!< @c derive_type, kept up to date by grow, shrink and augment.
+        unsigned char flags = 0;                  //!< @c scanned_bit and @c frozen_bit.
+        unsigned char rank = 0;                   //!< The rank of a representative of the blossoms.
+    };
+    static_assert(sizeof(NodeState) == 16, "NodeState should fill a quarter of a cache line.");
 
     const Graph &_g;
-    std::vector<NodeId> _phi;
-    std::vector<NodeId> _mu;
-    std::vector<NodeId> _rho;
-    std::vector<int> scanned;
+    const Engine _engine;
+    std::vector<NodeState> _state;
+    //! The base of every blossom, stored at the representative of its set. Only read once per rho.
+    std::vector<StateId> _base;
+    /**
+         * Contains every outer, unscanned node (and possibly nodes that stopped being outer or have been scanned
+         * since they were queued, those are skipped when they come up).
+         */
+    std::deque<NodeId> _outer_queue;
+    /**
+         * Path buffers of @c find_common_blossom, reused by every scan to avoid allocations.
+         */
+    Path _x_path;
+    Path _y_path;
+    /**
+         * The nodes of the two trees touched by the current augmentation, reused like the path buffers.
+         */
+    std::vector<NodeId> _tree_nodes;
+    /**
+         * Scratch marks of @c find_common_blossom (the blossoms passed by either path) and @c augment (which uses
+         * @c _x_marks), cleared before each use.
+         */
+    NodeMarker _x_marks;
+    NodeMarker _y_marks;
+    /**
+         * The adjacency matrix if bitsets are used, otherwise null. Then the bitsets below mirror the nodes of the
+         * forest, the inner nodes and the scanned and frozen flags (and are empty otherwise). Frozen nodes belong to
+         * trees that have been augmented in the current phase (only with @c Engine::phases). They are invisible to the
+         * search until the next phase.
+         */
+    const BitsetAdjacency *_dense;
+    NodeBitset _forest_bits;
+    NodeBitset _inner_bits;
+    NodeBitset _scanned_bits;
+    NodeBitset _frozen_bits;
+    //! The union of the rows of the nodes reset by @c augment.
+    std::vector<Word> _row_union;
+    //! The deadline, stop flag and checkpoint file of the run, or null if there are none.
+    const MatchingOptions *_options;
+    size_type _polls;
+    //! Whether the phase interrupted by the restored checkpoint had already augmented (see @c run_phases).
+    bool _resumed_phase_augmented;
+    //! An upper bound on the size of a maximum matching, the search stops once the matching has this size.
+    size_type _size_bound;
+    //! The size of the matching at which @c check_bound has to be called next.
+    size_type _bound_check;
+    //! Whether @c _size_bound already includes @c matching_upper_bound.
+    bool _bound_refined;
+    MatchingStatistics _stats;
 };
 
 // BEGIN: Inline section
 
 inline NodeType EdmondsMatching::get_type(NodeId node) const
 {
-    NodeId mu = _mu[node];
-    if (mu == node || _phi[mu] != mu)
+    assert(_state[node].type == derive_type(node));
+    return _state[node].type;
+}
+
+inline NodeType EdmondsMatching::derive_type(NodeId node) const
+{
+    NodeId mu = _state[node].mu;
+    if (mu == node || _state[mu].phi != mu)
     {
         return NodeType::outer;
     }
-    if (_phi[node] == node)
+    if (_state[node].phi == node)
     {
         return NodeType::out_of_forrest;
     }
@@ -147,6 +523,106 @@ inline NodeType EdmondsMatching::get_type(NodeId node) const
     return NodeType::inner;
 }
 
+inline void EdmondsMatching::update_type(NodeId node)
+{
+    _state[node].type = derive_type(node);
+}
+
+inline bool EdmondsMatching::has_flag(NodeId node, unsigned char flag) const
+{
+    return (_state[node].flags & flag) != 0;
+}
+
+inline void EdmondsMatching::queue_if_unscanned_outer(NodeId node)
+{
+    if (!has_flag(node, scanned_bit) && get_type(node) == NodeType::outer)
+    {
+        _outer_queue.push_back(node);
+    }
+}
+
+inline size_type EdmondsMatching::current_size() const
+{
+    return _stats.initial_size + _stats.augmentations;
+}
+
+inline void EdmondsMatching::set_scanned(NodeId node, bool value)
+{
+    if (value)
+    {
+        _state[node].flags |= scanned_bit;
+    }
+    else
+    {
+        _state[node].flags &= ~scanned_bit;
+    }
+    if (_dense != nullptr)
+    {
+        if (value)
+        {
+            _scanned_bits.set(node);
+        }
+        else
+        {
+            _scanned_bits.reset(node);
+        }
+    }
+}
+
+inline void EdmondsMatching::freeze(NodeId node)
+{
+    _state[node].flags |= frozen_bit;
+    if (_dense != nullptr)
+    {
+        _frozen_bits.set(node);
+    }
+}
+
+inline NodeId EdmondsMatching::find_blossom(NodeId node)
+{
+    // Path halving, as in UnionFind::find.
+    while (_state[node].blossom != node)
+    {
+        _state[node].blossom = _state[_state[node].blossom].blossom;
+        node = _state[node].blossom;
+    }
+    return node;
+}
+
+inline NodeId EdmondsMatching::rho(NodeId node)
+{
+    return _base[find_blossom(node)];
+}
+
+inline void EdmondsMatching::merge_blossom(NodeId node, NodeId root)
+{
+    NodeId a = find_blossom(node);
+    NodeId b = find_blossom(root);
+    if (a != b)
+    {
+        if (_state[a].rank < _state[b].rank)
+        {
+            std::swap(a, b);
+        }
+        _state[b].blossom = a;
+        if (_state[a].rank == _state[b].rank)
+        {
+            ++_state[a].rank;
+        }
+    }
+    _base[a] = root;
+}
+
+inline void EdmondsMatching::reset_node(NodeId node)
+{
+    NodeState &state = _state[node];
+    state.phi = node;
+    state.blossom = node;
+    state.rank = 0;
+    state.type = state.mu == node ? NodeType::outer : NodeType::out_of_forrest;
+    _base[node] = node;
+}
+
 // END: Inline section
 } // namespace ED
 
@@ -1,35 +1,85 @@
 #include "graph.hpp" // always include corresponding header first
 
-#include <fstream>
+#include "binary_graph.hpp"
+#include "dimacs_parser.hpp"
+#include "dimacs_writer.hpp"
+#include "mapped_file.hpp"
+#include "parallel.hpp"
+
+#include <istream>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <utility>
 
 
 namespace ED
 {
 /////////////////////////////////////////////
-//! \c Node definitions
+//! \c Graph definitions
 /////////////////////////////////////////////
 
-void Node::add_neighbor(NodeId const id)
+
+namespace
+{
+std::size_t adjacency_payload_size(DIMACS::BinaryHeader const & header)
 {
-   _neighbors.push_back(id);
+   return DIMACS::aligned_size((header.num_nodes + 1) * sizeof(size_type))
+          + DIMACS::aligned_size(2 * header.num_edges * sizeof(NodeId));
 }
+} // namespace
 
-/////////////////////////////////////////////
-//! \c Graph definitions
-/////////////////////////////////////////////
+Graph Graph::build_graph(const std::string & filename, unsigned const num_threads)
+{
+   if (DIMACS::is_binary_path(filename))
+   {
+      return load_binary(filename);
+   }
 
+   std::string cache = DIMACS::find_fresh_cache(filename, DIMACS::BinaryKind::adjacency, sizeof(NodeId));
+   if (!cache.empty())
+   {
+      return load_binary(cache);
+   }
+
+   return parse_dimacs(filename, num_threads);
+}
 
-Graph Graph::build_graph(const std::string & filename)
+Graph Graph::parse_dimacs(const std::string & filename, unsigned const num_threads)
 {
-   std::ifstream ifs(filename);
-   if (!ifs.is_open())
+   DIMACS::MappedFile file(filename);
+   DIMACS::Parser header_parser(file.begin(), file.end());
+
+   std::size_t num_nodes = 0;
+   std::size_t num_edges = 0;
+   header_parser.read_problem_line(num_nodes, num_edges);
+   DIMACS::check_id_range(num_nodes, "nodes");
+
+   auto const chunks = DIMACS::split_lines(header_parser.position(), file.end(),
+                                           DIMACS::resolve_thread_count(num_threads));
+   std::vector<GraphBuilder> parts;
+   parts.reserve(chunks.size());
+   for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk)
    {
-      throw std::runtime_error("Could not open input file.");
+      parts.emplace_back(num_nodes, num_edges / chunks.size() + 1);
    }
 
+   DIMACS::run_parallel(chunks.size(), [&chunks, &parts](unsigned const chunk)
+   {
+      DIMACS::Parser parser(chunks[chunk].first, chunks[chunk].second);
+      DimacsId i;
+      DimacsId j;
+      while (parser.next_edge(i, j))
+      {
+         parts[chunk].add_edge(from_dimacs_id(i), from_dimacs_id(j));
+      }
+   });
+
+   return GraphBuilder::build(parts);
+}
+
+Graph Graph::build_graph(std::istream & ifs)
+{
    std::string line;
 
    do
@@ -56,7 +106,7 @@ Graph Graph::build_graph(const std::string & filename)
       throw std::runtime_error("Unexpected format of input file.");
    }
 
-   Graph graph(num_nodes);
+   GraphBuilder builder(num_nodes, num_edges);
    while (std::getline(ifs, line))
    {
       if (line.empty() or line[0] != 'e')
@@ -69,36 +119,81 @@ Graph Graph::build_graph(const std::string & filename)
       DimacsId i;
       DimacsId j;
       stream >> c >> i >> j;
-      graph.add_edge(from_dimacs_id(i), from_dimacs_id(j));
+      builder.add_edge(from_dimacs_id(i), from_dimacs_id(j));
    }
 
-   return graph;
+   return builder.build();
+}
+
+Graph Graph::load_binary(const std::string & filename)
+{
+   auto file = DIMACS::map_binary(filename, DIMACS::BinaryKind::adjacency, sizeof(NodeId), 0, adjacency_payload_size);
+   auto const & header = DIMACS::binary_header(*file);
+
+   auto const offsets = DIMACS::binary_array<size_type>(*file, 0);
+   auto const neighbors = DIMACS::binary_array<NodeId>(
+      *file, DIMACS::aligned_size((header.num_nodes + 1) * sizeof(size_type)));
+   DIMACS::check_id_range(header.num_nodes, "nodes");
+   DIMACS::check_csr(offsets, header.num_nodes, neighbors, 2 * header.num_edges, header.num_nodes);
+
+   return Graph(file, static_cast<NodeId>(header.num_nodes), offsets, neighbors);
 }
 
 Graph::Graph(NodeId const num_nodes)
    :
-   _nodes(num_nodes),
-   _num_edges(0)
+   Graph(std::make_shared<Arrays const>(Arrays{std::vector<size_type>(num_nodes + 1, 0), {}}))
 {}
 
-void Graph::add_edge(NodeId node1_id, NodeId node2_id)
-{
-   if (node1_id == node2_id)
-   {
-      throw std::runtime_error("ED::Graph class does not support loops!");
-   }
+Graph::Graph(std::shared_ptr<Arrays const> const & arrays)
+   :
+   Graph(arrays, arrays->offsets.size() - 1, arrays->offsets.data(), arrays->neighbors.data())
+{}
 
-   // minimum redundancy :-), maybe a bit overkill...
-   auto impl = [this](NodeId a, NodeId b)
-   {
-      Node & node = _nodes.at(a);
-      node.add_neighbor(b);
-   };
+Graph::Graph(std::shared_ptr<void const> storage,
+             NodeId const num_nodes,
+             size_type const * offsets,
+             NodeId const * neighbors)
+   :
+   _storage(std::move(storage)),
+   _num_nodes(num_nodes),
+   _offsets(offsets),
+   _neighbors(neighbors)
+{}
 
-   impl(node1_id, node2_id);
-   impl(node2_id, node1_id);
+void Graph::write_binary_cache(const std::string & dmx_filename) const
+{
+   auto header = DIMACS::make_header(DIMACS::BinaryKind::adjacency, sizeof(NodeId), 0, num_nodes(), num_edges(),
+                                     DIMACS::source_stamp(dmx_filename));
+   DIMACS::write_binary(DIMACS::binary_cache_path(dmx_filename), header,
+                        {{_offsets, (_num_nodes + 1) * sizeof(size_type)},
+                         {_neighbors, 2 * num_edges() * sizeof(NodeId)}});
+}
+
+void Graph::write_dimacs(DIMACS::Writer & out) const
+{
+   out.put("c This encodes a graph in DIMACS format\n");
+   out.put("p edge ");
+   out.put_unsigned(num_nodes());
+   out.put(' ');
+   out.put_unsigned(num_edges());
+   out.put('\n');
 
-   ++_num_edges;
+   for (NodeId node_id = 0; node_id < _num_nodes; ++node_id)
+   {
+      for (size_type i = _offsets[node_id]; i < _offsets[node_id + 1]; ++i)
+      {
+         NodeId const neighbor_id = _neighbors[i];
+         // output each edge only once; ids are valid nodes, so adding 1 cannot overflow
+         if (node_id < neighbor_id)
+         {
+            out.put("e ");
+            out.put_unsigned(node_id + 1);
+            out.put(' ');
+            out.put_unsigned(neighbor_id + 1);
+            out.put('\n');
+         }
+      }
+   }
 }
 
 std::ostream & operator<<(std::ostream & str, Graph const & graph)
@@ -124,17 +219,135 @@ std::ostream & operator<<(std::ostream & str, Graph const & graph)
    return str;
 }
 
+/////////////////////////////////////////////
+//! \c GraphBuilder definitions
+/////////////////////////////////////////////
+
+GraphBuilder::GraphBuilder(NodeId const num_nodes, size_type const expected_num_edges)
+   :
+   _num_nodes(num_nodes),
+   _endpoints()
+{
+   _endpoints.reserve(2 * expected_num_edges);
+}
+
+void GraphBuilder::add_edge(NodeId node1_id, NodeId node2_id)
+{
+   if (node1_id == node2_id)
+   {
+      throw std::runtime_error("ED::Graph class does not support loops!");
+   }
+   if (node1_id >= _num_nodes or node2_id >= _num_nodes)
+   {
+      throw std::out_of_range("Edge endpoint is not a node of the graph.");
+   }
+
+   _endpoints.push_back(node1_id);
+   _endpoints.push_back(node2_id);
+}
+
+Graph GraphBuilder::build() const
+{
+   return scatter(this, 1);
+}
+
+Graph GraphBuilder::build(std::vector<GraphBuilder> const & parts)
+{
+   if (parts.empty())
+   {
+      throw std::runtime_error("Cannot build a graph from no parts.");
+   }
+   for (auto const & part : parts)
+   {
+      if (part._num_nodes != parts.front()._num_nodes)
+      {
+         throw std::runtime_error("All parts of a graph need the same number of nodes.");
+      }
+   }
+
+   return scatter(parts.data(), parts.size());
+}
+
+Graph GraphBuilder::scatter(GraphBuilder const * parts, size_type const num_parts)
+{
+   NodeId const num_nodes = parts[0]._num_nodes;
+
+   // First pass: every part counts the degrees of its own edges.
+   std::vector<std::vector<size_type>> next(num_parts);
+   DIMACS::run_parallel(num_parts, [parts, num_nodes, &next](unsigned const part)
+   {
+      next[part].assign(num_nodes, 0);
+      for (auto const node_id : parts[part]._endpoints)
+      {
+         ++next[part][node_id];
+      }
+   });
+
+   // Prefix sum over (node, part): the slots of a node are handed out to the parts in order, so the neighbors end up
+   // in the same order as if all edges had been added to a single builder.
+   auto arrays = std::make_shared<Graph::Arrays>();
+   auto & offsets = arrays->offsets;
+   offsets.resize(num_nodes + 1);
+   size_type sum = 0;
+   for (NodeId node_id = 0; node_id < num_nodes; ++node_id)
+   {
+      offsets[node_id] = sum;
+      for (size_type part = 0; part < num_parts; ++part)
+      {
+         size_type const degree = next[part][node_id];
+         next[part][node_id] = sum;
+         sum += degree;
+      }
+   }
+   offsets[num_nodes] = sum;
+
+   // Second pass: every part scatters its edges into the slots reserved for it.
+   auto & neighbors = arrays->neighbors;
+   neighbors.resize(sum);
+   DIMACS::run_parallel(num_parts, [parts, &next, &neighbors](unsigned const part)
+   {
+      auto const & endpoints = parts[part]._endpoints;
+      auto & slot = next[part];
+      for (size_type i = 0; i < endpoints.size(); i += 2)
+      {
+         NodeId const a = endpoints[i];
+         NodeId const b = endpoints[i + 1];
+         neighbors[slot[a]++] = b;
+         neighbors[slot[b]++] = a;
+      }
+   });
+
+   return Graph(arrays);
+}
+
 
 /////////////////////////////////////////////
 //! global functions
 /////////////////////////////////////////////
 
+void write_mate_array(DIMACS::Writer & out, Graph const & matching)
+{
+   out.put("c Mate array: line i holds the node matched to node i (0 if exposed)\n");
+   for (NodeId node_id = 0; node_id < matching.num_nodes(); ++node_id)
+   {
+      auto const neighbors = matching.node(node_id).neighbors();
+      if (neighbors.size() > 1)
+      {
+         throw std::runtime_error("Graph is not a matching.");
+      }
+      out.put_unsigned(neighbors.empty() ? 0 : neighbors[0] + 1);
+      out.put('\n');
+   }
+}
+
 NodeId from_dimacs_id(DimacsId const dimacs_id)
 {
    if (dimacs_id == 0)
    {
       throw std::runtime_error("Invalid (0) DIMACS id.");
    }
+   // Larger ids would wrap around to valid nodes.
+   DIMACS::check_id_range(dimacs_id, "nodes");
 
    return static_cast<NodeId>(dimacs_id - 1);
 }
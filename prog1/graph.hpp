@@ -4,14 +4,24 @@
 /**
    @file graph.hpp
 
-   @brief This file provides a simple class @c Graph to model unweighted undirected graphs.
+   @brief This file provides a simple immutable class @c Graph to model unweighted undirected graphs.
 **/
 
 #include <cstddef> // std::size_t
 #include <iosfwd> // std::ostream fwd declare
 #include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
+#include "index_type.hpp"
+
+namespace DIMACS
+{
+class Writer;
+} // namespace DIMACS
+
 namespace ED // for Edmonds
 {
 
@@ -24,7 +34,8 @@ using size_type = std::size_t;
 //! or a custom struct providing cast operator to \c size_type s.t.
 //! mixup of index types is avoided.
 //! This is not done here for simplicity.
-using NodeId = size_type;
+//! Node ids are 32 bits wide if built with DIMACS_INDEX32 (see index_type.hpp).
+using NodeId = DIMACS::Index;
 using DimacsId = size_type;
 
 /** Useful constant different from the id of any actual node: **/
@@ -36,13 +47,41 @@ DimacsId constexpr invalid_dimacs_id = std::numeric_limits<DimacsId>::max();
    These two trivial functions should help make the transition between the two models clear (instead of just having
    some unexplained -1's and +1's in the middle of the code.
 **/
-NodeId from_dimacs_id(DimacsId const dimacs_id); //!< Subtracts 1 (throws if @c dimacs_id is 0)
+NodeId from_dimacs_id(DimacsId const dimacs_id); //!< Subtracts 1 (throws if @c dimacs_id is 0 or too large)
 DimacsId to_dimacs_id(NodeId const node_id);     //!< Adds 1 (throws if overflow would occur)
 
+/**
+   @class NodeIdRange
+
+   @brief A read-only view of a contiguous array of node ids, usable in range-based for loops.
+**/
+class NodeIdRange
+{
+public:
+   typedef std::size_t size_type;
+   typedef NodeId const * const_iterator;
+
+   NodeIdRange(const_iterator begin, const_iterator end);
+
+   const_iterator begin() const;
+   const_iterator end() const;
+
+   size_type size() const;
+   bool empty() const;
+
+   NodeId operator[](size_type const i) const;
+
+private:
+   const_iterator _begin;
+   const_iterator _end;
+}; // class NodeIdRange
+
 /**
    @class Node
 
-   @brief A @c Node stores an array of neighbors (via their ids).
+   @brief A @c Node is a lightweight view of the neighbors of one node in a @c Graph (via their ids).
+
+   It does not own any memory and is only valid as long as the @c Graph it was obtained from.
 
    @note The neighbors are not necessarily ordered, so searching for a specific neighbor takes O(degree)-time.
 **/
@@ -51,38 +90,33 @@ class Node
 public:
    typedef std::size_t size_type;
 
-   /** @brief Create an isolated node (you can add neighbors later). **/
-   Node() = default;
-
    /** @return The number of neighbors of this node. **/
    size_type degree() const;
 
    /** @return The array of ids of the neighbors of this node. **/
-   std::vector<NodeId> const & neighbors() const;
+   NodeIdRange neighbors() const;
 
 private:
    friend class Graph;
+   friend class DynamicGraph;
 
-   /**
-      @brief Adds @c id to the list of neighbors of this node.
-      @warning Does not check whether @c id is already in the list of neighbors (a repeated neighbor is legal, and
-      models parallel edges).
-      @warning Does not check whether @c id is the identity of the node itself (which would create a loop!).
-   **/
-   void add_neighbor(NodeId const id);
+   explicit Node(NodeIdRange const neighbors);
 
-   std::vector<NodeId> _neighbors;
+   NodeIdRange _neighbors;
 }; // class Node
 
 /**
    @class Graph
 
-   @brief A @c Graph stores an array of @c Node s, but no array of edges. The list of edges is implicitly given
-   by the fact that the nodes know their neighbors.
+   @brief A @c Graph stores its adjacency in compressed sparse row (CSR) form: one array holding the neighbors of all
+   nodes back to back, and one array of offsets such that the neighbors of node @c v are the entries
+   <tt> [offsets[v], offsets[v + 1]) </tt>. There is no array of edges, every edge appears once in the adjacency of
+   each of its endpoints.
 
-   This class models undirected graphs only (in the sense that the method @c add_edge(node1, node2) adds both @c node1
-   as a neighbor of @c node2 and @c node2 as a neighbor of @c node1). It also forbids loops, but parallel edges are
-   legal.
+   A @c Graph is immutable, use a @c GraphBuilder to create one edge by edge. Since it cannot change, copies share
+   the same arrays. The arrays are either owned by the graph or live in a memory-mapped binary cache (@c .dmxb, see
+   binary_graph.hpp) that is kept mapped as long as any copy of the graph exists.
+   This class models undirected graphs only and forbids loops, but parallel edges are legal.
 
    @warning Nodes are numbered starting at 0, as is usually done in programming,
     instead starting at 1, as is done in the DIMACS format that your program should take as input!
@@ -95,15 +129,41 @@ public:
 
    /**
       @brief Creates the graph from the given file in DIMACS format.
+
+      If @c filename ends with @c .dmxb, it is loaded as a binary cache. Otherwise, if a fresh binary cache of the
+      file exists next to it, the cache is loaded instead of parsing the text.
+      @param num_threads The number of threads used to parse text (see @c parse_dimacs).
    **/
-   static Graph build_graph(const std::string & filename);
+   static Graph build_graph(const std::string & filename, unsigned const num_threads = 1);
 
    /**
-      @brief Creates a @c Graph with @c num_nodes isolated nodes.
+      @brief Parses the given file in DIMACS format, ignoring any binary cache.
+
+      The file is memory-mapped and parsed without per-line allocations. With more than one thread, the edge lines
+      are split into chunks at line boundaries, every thread parses one chunk into its own edge buffer, and the
+      buffers are merged into the adjacency by a parallel prefix-sum scatter. The result does not depend on the
+      number of threads.
+      @param num_threads The number of threads to use, 0 means one per hardware thread.
+   **/
+   static Graph parse_dimacs(const std::string & filename, unsigned const num_threads = 1);
 
-      The number of nodes in the graph currently cannot be changed. You can only add edges between the existing nodes.
+   /**
+      @brief Loads a binary cache written by @c write_binary_cache by mapping it. Throws if its arrays are inconsistent
+      (see @c DIMACS::check_csr), which takes one pass over them.
+   **/
+   static Graph load_binary(const std::string & filename);
+
+   /**
+      @brief Creates the graph from a DIMACS stream that cannot be mapped (e.g. a pipe).
+
+      This line-by-line path is considerably slower than the file-based overload.
+   **/
+   static Graph build_graph(std::istream & is);
+
+   /**
+      @brief Creates a @c Graph with @c num_nodes isolated nodes.
    **/
-   Graph(NodeId const num_nodes);
+   explicit Graph(NodeId const num_nodes);
 
    /** @return The number of nodes in the graph. **/
    NodeId num_nodes() const;
@@ -112,19 +172,22 @@ public:
    size_type num_edges() const;
 
    /**
-      @return A reference to the id-th entry in the array of @c Node s of this graph.
+      @return A view of the id-th node of this graph.
    **/
-   Node const & node(NodeId const id) const;
+   Node node(NodeId const id) const;
 
    /**
-      @brief Adds the edge <tt> {node1_id, node2_id} </tt> to this graph.
+      @brief Writes this graph as the binary cache of the DIMACS file @c dmx_filename it was read from.
 
-      Checks that @c node1_id and @c node2_id are distinct and throws an exception otherwise.
-      This method adds both @c node1_id as a neighbor of @c node2_id and @c node2_id as a neighbor of @c node1_id.
+      The cache is stored next to that file (@c foo.dmx becomes @c foo.dmxb) and stamped with its current size and
+      modification time.
+   **/
+   void write_binary_cache(const std::string & dmx_filename) const;
 
-      @warning Does not check that the edge does not already exist, so this class can be used to model non-simple graphs.
+   /**
+      @brief Writes the graph in DIMACS format, the same text as @c operator<< produces, but much faster.
    **/
-   void add_edge(NodeId node1_id, NodeId node2_id);
+   void write_dimacs(DIMACS::Writer & out) const;
 
    /**
      @brief Prints the graph to the given ostream in DIMACS format.
@@ -132,12 +195,128 @@ public:
    friend std::ostream & operator<<(std::ostream & str, Graph const & graph);
 
 private:
-   std::vector<Node> _nodes;
-   std::size_t _num_edges;
+   friend class GraphBuilder;
+
+   //! The arrays of a graph that owns its memory.
+   struct Arrays
+   {
+      std::vector<size_type> offsets;
+      std::vector<NodeId> neighbors;
+   };
+
+   explicit Graph(std::shared_ptr<Arrays const> const & arrays);
+
+   Graph(std::shared_ptr<void const> storage,
+         NodeId const num_nodes,
+         size_type const * offsets,
+         NodeId const * neighbors);
+
+   std::shared_ptr<void const> _storage; //!< Keeps the arrays below alive (either @c Arrays or a mapped file).
+   NodeId _num_nodes;
+   size_type const * _offsets;
+   NodeId const * _neighbors;
 }; // class Graph
 
+/**
+   @class GraphBuilder
+
+   @brief Collects the edges of a @c Graph and then lays out its CSR adjacency in two passes: the first counts the
+   degrees, the second scatters every edge into the slots reserved for its endpoints.
+
+   The neighbors of every node end up in the order in which their edges were added.
+**/
+class GraphBuilder
+{
+public:
+   typedef std::size_t size_type;
+
+   /**
+      @brief Prepares a graph with @c num_nodes isolated nodes.
+      @param expected_num_edges Used to reserve memory only (e.g. the edge count of a DIMACS problem line).
+   **/
+   explicit GraphBuilder(NodeId const num_nodes, size_type const expected_num_edges = 0);
+
+   /** @return The number of nodes in the graph being built. **/
+   NodeId num_nodes() const;
+
+   /**
+      @brief Adds the edge <tt> {node1_id, node2_id} </tt>.
+
+      Checks that @c node1_id and @c node2_id are distinct and existing nodes and throws an exception otherwise.
+
+      @warning Does not check that the edge does not already exist, so this class can be used to model non-simple graphs.
+   **/
+   void add_edge(NodeId node1_id, NodeId node2_id);
+
+   /** @return The @c Graph consisting of all edges added so far. **/
+   Graph build() const;
+
+   /**
+      @return The @c Graph consisting of the edges of all @c parts, which have to agree on the number of nodes.
+
+      Edges are ordered as if the parts had been added one after the other. Every part is counted and scattered by
+      its own thread.
+   **/
+   static Graph build(std::vector<GraphBuilder> const & parts);
+
+private:
+   static Graph scatter(GraphBuilder const * parts, size_type const num_parts);
+
+   NodeId _num_nodes;
+   std::vector<NodeId> _endpoints; //!< Edge i is {_endpoints[2i], _endpoints[2i + 1]}.
+}; // class GraphBuilder
+
+/**
+   @brief Writes only the mate array of @c matching: line @c i holds the DIMACS id of the node matched to node @c i, or 0
+   if node @c i is exposed. Throws if @c matching is not a matching.
+**/
+void write_mate_array(DIMACS::Writer & out, Graph const & matching);
+
 //BEGIN: Inline section
 
+inline
+NodeIdRange::NodeIdRange(const_iterator begin, const_iterator end)
+   :
+   _begin(begin),
+   _end(end)
+{}
+
+inline
+NodeIdRange::const_iterator NodeIdRange::begin() const
+{
+   return _begin;
+}
+
+inline
+NodeIdRange::const_iterator NodeIdRange::end() const
+{
+   return _end;
+}
+
+inline
+NodeIdRange::size_type NodeIdRange::size() const
+{
+   return static_cast<size_type>(_end - _begin);
+}
+
+inline
+bool NodeIdRange::empty() const
+{
+   return _begin == _end;
+}
+
+inline
+NodeId NodeIdRange::operator[](size_type const i) const
+{
+   return _begin[i];
+}
+
+inline
+Node::Node(NodeIdRange const neighbors)
+   :
+   _neighbors(neighbors)
+{}
+
 inline
 Node::size_type Node::degree() const
 {
@@ -145,7 +324,7 @@ Node::size_type Node::degree() const
 }
 
 inline
-std::vector<NodeId> const & Node::neighbors() const
+NodeIdRange Node::neighbors() const
 {
    return _neighbors;
 }
@@ -153,20 +332,30 @@ std::vector<NodeId> const & Node::neighbors() const
 inline
 NodeId Graph::num_nodes() const
 {
-   return _nodes.size();
+   return _num_nodes;
 }
 
 inline
 Graph::size_type Graph::num_edges() const
 {
-   return _num_edges;
+   return _offsets[_num_nodes] / 2;
 }
 
 inline
-Node const & Graph::node(NodeId const id) const
+Node Graph::node(NodeId const id) const
 {
    // perform index checking
-   return _nodes.at(id);
+   if (id >= num_nodes())
+   {
+      throw std::out_of_range("Invalid node id.");
+   }
+   return Node(NodeIdRange(_neighbors + _offsets[id], _neighbors + _offsets[id + 1]));
+}
+
+inline
+NodeId GraphBuilder::num_nodes() const
+{
+   return _num_nodes;
 }
 //END: Inline section
 
@@ -0,0 +1,359 @@
+#include "initial_matching.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace ED
+{
+namespace
+{
+std::vector<NodeId> empty_matching(const Graph &g)
+{
+    std::vector<NodeId> mate(g.num_nodes());
+    for (NodeId v = 0; v < g.num_nodes(); ++v)
+    {
+        mate[v] = v;
+    }
+    return mate;
+}
+
+std::vector<NodeId> greedy_matching(const Graph &g)
+{
+    std::vector<NodeId> mate = empty_matching(g);
+    extend_greedily(g, mate);
+    return mate;
+}
+
+/**
+ * Keeps track of the number of exposed neighbors of every exposed node while nodes get matched.
+ */
+class RemainingDegrees
+{
+  public:
+    explicit RemainingDegrees(const Graph &g) : _g(g), _mate(empty_matching(g)), _degree(g.num_nodes())
+    {
+        for (NodeId v = 0; v < g.num_nodes(); ++v)
+        {
+            _degree[v] = g.node(v).degree();
+        }
+    }
+
+    bool exposed(NodeId v) const
+    {
+        return _mate[v] == v;
+    }
+
+    size_type degree(NodeId v) const
+    {
+        return _degree[v];
+    }
+
+    /**
+     * Matches @c v and @c w and calls @c f(u) for every exposed neighbor @c u whose degree dropped.
+     */
+    template <typename func>
+    void match(NodeId v, NodeId w, func f)
+    {
+        _mate[v] = w;
+        _mate[w] = v;
+        for (auto matched : {v, w})
+        {
+            for (auto u : _g.node(matched).neighbors())
+            {
+                if (exposed(u))
+                {
+                    --_degree[u];
+                    f(u);
+                }
+            }
+        }
+    }
+
+    std::vector<NodeId> &mate()
+    {
+        return _mate;
+    }
+
+  private:
+    const Graph &_g;
+    std::vector<NodeId> _mate;
+    std::vector<size_type> _degree;
+};
+
+std::vector<NodeId> min_degree_matching(const Graph &g)
+{
+    RemainingDegrees rd(g);
+
+    // Bucket queue over the remaining degrees. Degrees only decrease, so nodes are pushed again into their new bucket
+    // and stale entries are skipped.
+    size_type max_degree = 0;
+    for (NodeId v = 0; v < g.num_nodes(); ++v)
+    {
+        max_degree = std::max(max_degree, rd.degree(v));
+    }
+    std::vector<std::vector<NodeId>> buckets(max_degree + 1);
+    for (NodeId v = 0; v < g.num_nodes(); ++v)
+    {
+        buckets[rd.degree(v)].push_back(v);
+    }
+
+    // Nodes of degree 0 can never be matched, so bucket 0 is never looked at.
+    size_type min = 1;
+    auto push = [&buckets, &rd, &min](NodeId u) {
+        if (rd.degree(u) > 0)
+        {
+            buckets[rd.degree(u)].push_back(u);
+            min = std::min(min, rd.degree(u));
+        }
+    };
+
+    while (true)
+    {
+        while (min <= max_degree && buckets[min].empty())
+        {
+            ++min;
+        }
+        if (min > max_degree)
+        {
+            break;
+        }
+
+        NodeId v = buckets[min].back();
+        buckets[min].pop_back();
+        if (!rd.exposed(v) || rd.degree(v) != min)
+        {
+            continue;
+        }
+
+        NodeId best = invalid_node_id;
+        for (auto w : g.node(v).neighbors())
+        {
+            if (rd.exposed(w) && (best == invalid_node_id || rd.degree(w) < rd.degree(best)))
+            {
+                best = w;
+            }
+        }
+        rd.match(v, best, push);
+    }
+
+    return std::move(rd.mate());
+}
+
+std::vector<NodeId> karp_sipser_matching(const Graph &g)
+{
+    RemainingDegrees rd(g);
+
+    std::vector<NodeId> degree_one;
+    for (NodeId v = 0; v < g.num_nodes(); ++v)
+    {
+        if (rd.degree(v) == 1)
+        {
+            degree_one.push_back(v);
+        }
+    }
+    auto push = [&degree_one, &rd](NodeId u) {
+        if (rd.degree(u) == 1)
+        {
+            degree_one.push_back(u);
+        }
+    };
+
+    auto match_first_exposed_neighbor = [&g, &rd, &push](NodeId v) {
+        for (auto w : g.node(v).neighbors())
+        {
+            if (rd.exposed(w))
+            {
+                rd.match(v, w, push);
+                return;
+            }
+        }
+    };
+
+    // Matching a node of degree 1 to its only neighbor is always part of some maximum matching. Only if there is no
+    // such node, an arbitrary edge is taken.
+    NodeId next = 0;
+    while (true)
+    {
+        if (!degree_one.empty())
+        {
+            NodeId v = degree_one.back();
+            degree_one.pop_back();
+            if (rd.exposed(v) && rd.degree(v) == 1)
+            {
+                match_first_exposed_neighbor(v);
+            }
+            continue;
+        }
+
+        while (next < g.num_nodes() && (!rd.exposed(next) || rd.degree(next) == 0))
+        {
+            ++next;
+        }
+        if (next == g.num_nodes())
+        {
+            break;
+        }
+        match_first_exposed_neighbor(next);
+    }
+
+    return std::move(rd.mate());
+}
+} // namespace
+
+Initialization parse_initialization(const std::string &name)
+{
+    if (name == "empty")
+    {
+        return Initialization::empty;
+    }
+    if (name == "greedy")
+    {
+        return Initialization::greedy;
+    }
+    if (name == "min-degree")
+    {
+        return Initialization::min_degree;
+    }
+    if (name == "karp-sipser")
+    {
+        return Initialization::karp_sipser;
+    }
+    throw std::runtime_error("Unknown initialization " + name + ".");
+}
+
+std::vector<NodeId> initial_matching(const Graph &g, Initialization init)
+{
+    switch (init)
+    {
+    case Initialization::greedy:
+        return greedy_matching(g);
+    case Initialization::min_degree:
+        return min_degree_matching(g);
+    case Initialization::karp_sipser:
+        return karp_sipser_matching(g);
+    case Initialization::empty:
+        break;
+    }
+    return empty_matching(g);
+}
+
+void extend_greedily(const Graph &g, std::vector<NodeId> &mate)
+{
+    for (NodeId v = 0; v < g.num_nodes(); ++v)
+    {
+        if (mate[v] != v)
+        {
+            continue;
+        }
+        for (auto w : g.node(v).neighbors())
+        {
+            if (mate[w] == w)
+            {
+                mate[v] = w;
+                mate[w] = v;
+                break;
+            }
+        }
+    }
+}
+
+Graph read_matching(const std::string &filename)
+{
+    std::ifstream file(filename);
+    if (!file)
+    {
+        throw std::runtime_error("Cannot open matching file " + filename + ".");
+    }
+
+    // The DIMACS format starts with its problem line, the mate array has none.
+    std::vector<NodeId> mate;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == 'c')
+        {
+            continue;
+        }
+        if (line[0] == 'p')
+        {
+            file.close();
+            return Graph::parse_dimacs(filename);
+        }
+        DimacsId const id = std::stoull(line);
+        mate.push_back(id == 0 ? mate.size() : from_dimacs_id(id));
+    }
+
+    GraphBuilder matching(mate.size(), mate.size() / 2);
+    for (NodeId v = 0; v < mate.size(); ++v)
+    {
+        if (mate[v] > v)
+        {
+            matching.add_edge(v, mate[v]);
+        }
+    }
+    return matching.build();
+}
+
+std::vector<NodeId> warm_start_matching(const Graph &g, const Graph &matching, size_type &dropped)
+{
+    std::vector<NodeId> mate = empty_matching(g);
+    dropped = 0;
+    for (NodeId v = 0; v < matching.num_nodes(); ++v)
+    {
+        for (auto w : matching.node(v).neighbors())
+        {
+            if (w < v)
+            {
+                continue;
+            }
+            bool valid = w < g.num_nodes() && mate[v] == v && mate[w] == w;
+            if (valid)
+            {
+                // Looks the edge up at the endpoint with fewer neighbors.
+                NodeId from = g.node(v).degree() <= g.node(w).degree() ? v : w;
+                NodeId to = from == v ? w : v;
+                NodeIdRange neighbors = g.node(from).neighbors();
+                valid = std::find(neighbors.begin(), neighbors.end(), to) != neighbors.end();
+            }
+            if (valid)
+            {
+                mate[v] = w;
+                mate[w] = v;
+            }
+            else
+            {
+                ++dropped;
+            }
+        }
+    }
+    return mate;
+}
+
+size_type matching_size(const std::vector<NodeId> &mate)
+{
+    size_type size = 0;
+    for (NodeId v = 0; v < mate.size(); ++v)
+    {
+        if (mate[v] > v)
+        {
+            ++size;
+        }
+    }
+    return size;
+}
+
+Graph matching_graph(const std::vector<NodeId> &mate)
+{
+    GraphBuilder g(mate.size(), mate.size() / 2);
+    for (NodeId v = 0; v < mate.size(); ++v)
+    {
+        if (mate[v] < v)
+        {
+            g.add_edge(v, mate[v]);
+        }
+    }
+    return g.build();
+}
+
+} // namespace ED
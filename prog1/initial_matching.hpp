@@ -0,0 +1,74 @@
+#ifndef INITIAL_MATCHING_HPP
+#define INITIAL_MATCHING_HPP
+
+#include "graph.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * @file initial_matching.hpp
+ *
+ * @brief This file provides cheap heuristics that compute a maximal (but not necessarily maximum) matching to start
+ * @c EdmondsMatching from. Every heuristic runs in O(n + m) time.
+ *
+ * Matchings are given as mate arrays in the convention of @c EdmondsMatching: @c mate[v] is the node matched to
+ * @c v, or @c v itself if @c v is exposed.
+ */
+namespace ED
+{
+/**
+ * The available ways to compute the initial matching.
+ */
+enum class Initialization
+{
+    empty,       //!< start from the empty matching
+    greedy,      //!< match every node to its first exposed neighbor, in order of the node ids
+    min_degree,  //!< repeatedly match an exposed node of minimum remaining degree to its neighbor of minimum degree
+    karp_sipser  //!< repeatedly match a node of remaining degree 1 to its only neighbor, otherwise act greedily
+};
+
+/**
+ * @return The initialization named @c name (one of "empty", "greedy", "min-degree", "karp-sipser"). Throws if there
+ * is no such initialization.
+ */
+Initialization parse_initialization(const std::string &name);
+
+/**
+ * @return The initial matching of @c g computed by @c init.
+ */
+std::vector<NodeId> initial_matching(const Graph &g, Initialization init);
+
+/**
+ * Matches every exposed node to its first exposed neighbor, in order of the node ids, so that @c mate becomes maximal.
+ */
+void extend_greedily(const Graph &g, std::vector<NodeId> &mate);
+
+/**
+ * @return The matching stored in @c filename in one of the formats edmonds.out writes: in DIMACS format, or as mate
+ * array (line @c i holding the DIMACS id of the mate of node @c i, or 0). The matching is not checked, it may even
+ * contain nodes with several edges.
+ */
+Graph read_matching(const std::string &filename);
+
+/**
+ * @return The mate array of the edges of @c matching that are edges of @c g, e.g. of a matching computed for an
+ * earlier version of @c g. Edges with a node that is not in @c g, or that share a node with an edge taken before
+ * (in the order of their smaller node), are dropped. Takes O(n + sum of min(degree) over the edges) time.
+ * @param dropped Receives the number of dropped edges.
+ */
+std::vector<NodeId> warm_start_matching(const Graph &g, const Graph &matching, size_type &dropped);
+
+/**
+ * @return The number of edges of the matching given by the mate array @c mate.
+ */
+size_type matching_size(const std::vector<NodeId> &mate);
+
+/**
+ * @return A @c Graph on the nodes of the mate array @c mate containing exactly the edges of the matching.
+ */
+Graph matching_graph(const std::vector<NodeId> &mate);
+
+} // namespace ED
+
+#endif // INITIAL_MATCHING_HPP
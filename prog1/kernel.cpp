@@ -0,0 +1,257 @@
+#include "kernel.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace ED
+{
+Kernelization::Kernelization(const Graph &g) : _g(g),
+                                               _owns_list(g.num_nodes(), false),
+                                               _adjacent(g.num_nodes()),
+                                               _degree(g.num_nodes()),
+                                               _removed(g.num_nodes(), false),
+                                               _mate(g.num_nodes()),
+                                               _marks(g.num_nodes()),
+                                               _kernel(0)
+{
+    for (NodeId v = 0; v < g.num_nodes(); ++v)
+    {
+        _mate[v] = v;
+        _marks.clear();
+        _marks.mark(v);
+        for (auto w : g.node(v).neighbors())
+        {
+            if (!_marks.is_marked(w))
+            {
+                _marks.mark(w);
+                ++_degree[v];
+            }
+        }
+        // Only nodes with loops or parallel edges need their own list from the start, without them.
+        if (_degree[v] != g.node(v).degree())
+        {
+            _marks.clear();
+            _marks.mark(v);
+            for (auto w : g.node(v).neighbors())
+            {
+                if (!_marks.is_marked(w))
+                {
+                    _marks.mark(w);
+                    _adjacent[v].push_back(w);
+                }
+            }
+            _owns_list[v] = true;
+        }
+        push(v);
+    }
+
+    // Nodes of degree at most one first: they never increase a degree, while folds may.
+    while (!_low_degree.empty() || !_degree_two.empty())
+    {
+        NodeId v;
+        if (!_low_degree.empty())
+        {
+            v = _low_degree.back();
+            _low_degree.pop_back();
+        }
+        else
+        {
+            v = _degree_two.back();
+            _degree_two.pop_back();
+        }
+        // Nodes are queued whenever their degree drops to at most 2, so entries may be outdated.
+        if (_removed[v] || _degree[v] > 2)
+        {
+            continue;
+        }
+
+        NodeId current[2];
+        size_type num_current = 0;
+        for (auto w : neighbors(v))
+        {
+            if (!_removed[w])
+            {
+                assert(num_current < _degree[v]);
+                current[num_current++] = w;
+            }
+        }
+        assert(num_current == _degree[v]);
+
+        if (num_current == 0)
+        {
+            _removed[v] = true;
+            ++_stats.isolated;
+        }
+        else if (num_current == 1)
+        {
+            _mate[v] = current[0];
+            _mate[current[0]] = v;
+            remove(v);
+            remove(current[0]);
+            ++_stats.degree_one;
+        }
+        else
+        {
+            fold(v, current[0], current[1]);
+            ++_stats.degree_two;
+        }
+    }
+
+    // The kernel consists of the remaining nodes, all of degree at least 3.
+    std::vector<NodeId> kernel_id(g.num_nodes(), invalid_node_id);
+    size_type num_edges = 0;
+    for (NodeId v = 0; v < g.num_nodes(); ++v)
+    {
+        if (!_removed[v])
+        {
+            kernel_id[v] = _kernel_nodes.size();
+            _kernel_nodes.push_back(v);
+            num_edges += _degree[v];
+        }
+    }
+    if (_kernel_nodes.size() == g.num_nodes())
+    {
+        // Nothing to reduce, the kernel shares the arrays of g.
+        _kernel = g;
+        _stats.kernel_nodes = _kernel.num_nodes();
+        _stats.kernel_edges = _kernel.num_edges();
+        return;
+    }
+    GraphBuilder builder(_kernel_nodes.size(), num_edges / 2);
+    for (auto v : _kernel_nodes)
+    {
+        for (auto w : neighbors(v))
+        {
+            if (v < w && !_removed[w])
+            {
+                builder.add_edge(kernel_id[v], kernel_id[w]);
+            }
+        }
+    }
+    _kernel = builder.build();
+    _stats.kernel_nodes = _kernel.num_nodes();
+    _stats.kernel_edges = _kernel.num_edges();
+}
+
+void Kernelization::own_list(NodeId v)
+{
+    std::vector<NodeId> current;
+    current.reserve(_degree[v]);
+    for (auto w : neighbors(v))
+    {
+        if (!_removed[w])
+        {
+            current.push_back(w);
+        }
+    }
+    _adjacent[v].swap(current);
+    _owns_list[v] = true;
+}
+
+void Kernelization::push(NodeId v)
+{
+    if (_degree[v] <= 1)
+    {
+        _low_degree.push_back(v);
+    }
+    else if (_degree[v] == 2)
+    {
+        _degree_two.push_back(v);
+    }
+}
+
+void Kernelization::remove(NodeId v)
+{
+    _removed[v] = true;
+    for (auto w : neighbors(v))
+    {
+        if (!_removed[w])
+        {
+            --_degree[w];
+            push(w);
+        }
+    }
+}
+
+void Kernelization::fold(NodeId v, NodeId u, NodeId w)
+{
+    // The node with more neighbors survives, so fewer adjacency lists have to be extended.
+    NodeId survivor = _degree[u] >= _degree[w] ? u : w;
+    NodeId merged = survivor == u ? w : u;
+    _removed[v] = true;
+    _removed[merged] = true;
+    _folds.push_back(Fold{v, survivor, merged});
+
+    // Drops the removed nodes from the list of the survivor.
+    own_list(survivor);
+    _marks.clear();
+    for (auto x : _adjacent[survivor])
+    {
+        _marks.mark(x);
+    }
+
+    // Neighbors of the merged node that are adjacent to the survivor just lose one neighbor, the others are moved
+    // over. The entries of the merged node in their lists are skipped from now on.
+    for (auto x : neighbors(merged))
+    {
+        if (_removed[x] || x == survivor)
+        {
+            continue;
+        }
+        if (_marks.is_marked(x))
+        {
+            --_degree[x];
+            push(x);
+        }
+        else
+        {
+            if (!_owns_list[x])
+            {
+                own_list(x);
+            }
+            _adjacent[survivor].push_back(x);
+            _adjacent[x].push_back(survivor);
+        }
+    }
+    _degree[survivor] = _adjacent[survivor].size();
+    push(survivor);
+}
+
+std::vector<NodeId> Kernelization::lift(const std::vector<NodeId> &kernel_mate) const
+{
+    std::vector<NodeId> mate = _mate;
+    for (NodeId i = 0; i < _kernel_nodes.size(); ++i)
+    {
+        mate[_kernel_nodes[i]] = _kernel_nodes[kernel_mate[i]];
+    }
+
+    // Undo the folds from the last to the first, so the matching is one of the graph right after each fold. The
+    // partner of the folded node is a neighbor of the survivor or of the merged node, which is matched to it, and the
+    // pivot takes the other one. The neighbors of the merged node have not changed since its fold.
+    for (auto it = _folds.rbegin(); it != _folds.rend(); ++it)
+    {
+        NodeId partner = mate[it->survivor];
+        NodeIdRange merged_neighbors = neighbors(it->merged);
+        if (partner != it->survivor &&
+            std::find(merged_neighbors.begin(), merged_neighbors.end(), partner) != merged_neighbors.end())
+        {
+            mate[partner] = it->merged;
+            mate[it->merged] = partner;
+            mate[it->pivot] = it->survivor;
+            mate[it->survivor] = it->pivot;
+        }
+        else if (partner != it->survivor)
+        {
+            mate[it->pivot] = it->merged;
+            mate[it->merged] = it->pivot;
+        }
+        else
+        {
+            mate[it->pivot] = it->survivor;
+            mate[it->survivor] = it->pivot;
+        }
+    }
+    return mate;
+}
+
+} // namespace ED
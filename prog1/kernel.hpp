@@ -0,0 +1,129 @@
+#ifndef KERNEL_HPP
+#define KERNEL_HPP
+
+#include "graph.hpp"
+#include "node_marker.hpp"
+
+#include <vector>
+
+/**
+ * @file kernel.hpp
+ *
+ * @brief This file provides exact reductions that shrink a graph before a maximum matching is searched in it. Each
+ * rule removes nodes such that a maximum matching of the remaining graph (the kernel) can be extended to a maximum
+ * matching of the original graph:
+ *  - A node without neighbors is exposed in every matching and is removed.
+ *  - A node with a single neighbor is matched to it, both are removed.
+ *  - A node @c v with exactly two neighbors @c u and @c w is folded: @c v, @c u and @c w are replaced by a single node
+ *    adjacent to all other neighbors of @c u and @c w. The original graph has a maximum matching with one more edge
+ *    than the folded one, which is recovered when the fold is undone.
+ */
+namespace ED
+{
+/**
+ * How much each rule removed.
+ */
+struct ReductionStatistics
+{
+    size_type isolated = 0;     //!< Number of nodes removed without neighbors.
+    size_type degree_one = 0;   //!< Number of nodes with one neighbor that were matched to it.
+    size_type degree_two = 0;   //!< Number of folded nodes with two neighbors.
+    size_type kernel_nodes = 0; //!< Number of nodes left in the kernel.
+    size_type kernel_edges = 0; //!< Number of edges left in the kernel.
+};
+
+/**
+ * @class Kernelization
+ *
+ * @brief Applies the reductions to a @c Graph until none applies any more, and extends matchings of the kernel to
+ * the graph. Loops and parallel edges are ignored. Folds cost time proportional to the degrees of the two neighbors.
+ * The graph has to outlive this object.
+ */
+class Kernelization
+{
+  public:
+    explicit Kernelization(const Graph &g);
+
+    /**
+     * @return The remaining graph, whose nodes are numbered in the order of their ids in the original graph.
+     */
+    const Graph &kernel() const;
+
+    const ReductionStatistics &statistics() const;
+
+    /**
+     * @param kernel_mate A maximum matching of @c kernel as mate array (see initial_matching.hpp).
+     * @return The maximum matching of the original graph obtained by adding the edges matched by the reductions and
+     * undoing the folds.
+     */
+    std::vector<NodeId> lift(const std::vector<NodeId> &kernel_mate) const;
+
+  private:
+    //! A node @c pivot with the neighbors @c survivor and @c merged, the latter being merged into the former.
+    struct Fold
+    {
+        NodeId pivot;
+        NodeId survivor;
+        NodeId merged;
+    };
+
+    //! Removes @c v and updates the degrees of its neighbors.
+    void remove(NodeId v);
+
+    //! Folds @c v, which has exactly the two neighbors @c u and @c w.
+    void fold(NodeId v, NodeId u, NodeId w);
+
+    //! Queues @c v for the rules if its degree is at most 2.
+    void push(NodeId v);
+
+    //! The current neighbors of @c v, and possibly removed nodes.
+    NodeIdRange neighbors(NodeId v) const;
+
+    //! Makes @c v use its own adjacency list (containing only the current neighbors), so that nodes can be added.
+    void own_list(NodeId v);
+
+    const Graph &_g;
+    //! Nodes use their neighbors in @c _g until a fold changes them, then their own list in @c _adjacent.
+    std::vector<unsigned char> _owns_list;
+    std::vector<std::vector<NodeId>> _adjacent;
+    //! The number of distinct neighbors that have not been removed.
+    std::vector<size_type> _degree;
+    std::vector<unsigned char> _removed;
+    //! The edges matched by the degree-one rule.
+    std::vector<NodeId> _mate;
+    std::vector<Fold> _folds;
+    std::vector<NodeId> _low_degree;
+    std::vector<NodeId> _degree_two;
+    NodeMarker _marks;
+
+    //! The original id of every node of the kernel.
+    std::vector<NodeId> _kernel_nodes;
+    Graph _kernel;
+    ReductionStatistics _stats;
+};
+
+// BEGIN: Inline section
+
+inline const Graph &Kernelization::kernel() const
+{
+    return _kernel;
+}
+
+inline const ReductionStatistics &Kernelization::statistics() const
+{
+    return _stats;
+}
+
+inline NodeIdRange Kernelization::neighbors(NodeId v) const
+{
+    if (_owns_list[v])
+    {
+        return NodeIdRange(_adjacent[v].data(), _adjacent[v].data() + _adjacent[v].size());
+    }
+    return _g.node(v).neighbors();
+}
+
+// END: Inline section
+} // namespace ED
+
+#endif // KERNEL_HPP
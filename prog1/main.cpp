@@ -1,21 +1,263 @@
+#include <atomic>
+#include <chrono>
+#include <csignal>
 #include <iostream>
 #include <cstdlib>
+#include <memory>
+#include <string>
 
+#include <unistd.h>
+
+#include "approximate.hpp"
+#include "certificate.hpp"
+#include "dimacs_writer.hpp"
 #include "graph.hpp"
 #include "edmonds.hpp"
 
+namespace
+{
+// Set by the signal handlers, polled by the search.
+std::atomic<bool> stop_requested(false);
+std::atomic<bool> checkpoint_requested(false);
+
+extern "C" void request_stop(int)
+{
+   stop_requested = true;
+}
+
+extern "C" void request_checkpoint(int)
+{
+   checkpoint_requested = true;
+}
+} // namespace
+
 int main(int argc, char **argv)
 {
-   if (argc != 2)
+   std::string const usage =
+      "Program call: <program_name> [--threads <num>] [--output <file>] [--mates] "
+      "[--init empty|greedy|min-degree|karp-sipser] [--warm-start <matching file>] [--engine edmonds|phases] [--adjacency auto|lists|bitsets] [--approximate <epsilon>] [--bipartite] [--kernel] [--order none|bfs|rcm|degree] [--no-upper-bound] [--stats] [--certificate <file>] "
+      "[--time-limit <seconds>] [--checkpoint <file>] [--resume <checkpoint file>] <input_graph>";
+
+   unsigned num_threads = 1;
+   ED::MatchingOptions options;
+   options.initialization = ED::Initialization::karp_sipser;
+   bool print_stats = false;
+   std::string output;
+   bool mates_only = false;
+   std::string input;
+   std::string warm_start;
+   std::string certificate;
+   double epsilon = 0;
+   double time_limit = 0;
+   for (int i = 1; i < argc; ++i)
+   {
+      std::string const arg = argv[i];
+      if (arg == "--threads" and i + 1 < argc)
+      {
+         num_threads = static_cast<unsigned>(std::stoul(argv[++i]));
+      }
+      else if (arg == "--output" and i + 1 < argc)
+      {
+         output = argv[++i];
+      }
+      else if (arg == "--mates")
+      {
+         mates_only = true;
+      }
+      else if (arg == "--init" and i + 1 < argc)
+      {
+         options.initialization = ED::parse_initialization(argv[++i]);
+      }
+      else if (arg == "--warm-start" and i + 1 < argc)
+      {
+         warm_start = argv[++i];
+      }
+      else if (arg == "--engine" and i + 1 < argc)
+      {
+         options.engine = ED::parse_engine(argv[++i]);
+      }
+      else if (arg == "--adjacency" and i + 1 < argc)
+      {
+         options.adjacency = ED::parse_adjacency(argv[++i]);
+      }
+      else if (arg == "--approximate" and i + 1 < argc)
+      {
+         epsilon = std::stod(argv[++i]);
+      }
+      else if (arg == "--no-upper-bound")
+      {
+         options.upper_bound = false;
+      }
+      else if (arg == "--kernel")
+      {
+         options.kernelize = true;
+      }
+      else if (arg == "--order" and i + 1 < argc)
+      {
+         options.order = DIMACS::parse_node_order(argv[++i]);
+      }
+      else if (arg == "--bipartite")
+      {
+         options.bipartite_fast_path = true;
+      }
+      else if (arg == "--certificate" and i + 1 < argc)
+      {
+         certificate = argv[++i];
+      }
+      else if (arg == "--time-limit" and i + 1 < argc)
+      {
+         time_limit = std::stod(argv[++i]);
+      }
+      else if (arg == "--checkpoint" and i + 1 < argc)
+      {
+         options.checkpoint = argv[++i];
+      }
+      else if (arg == "--resume" and i + 1 < argc)
+      {
+         options.resume = argv[++i];
+      }
+      else if (arg == "--stats")
+      {
+         print_stats = true;
+      }
+      else if (input.empty() and arg.compare(0, 2, "--") != 0)
+      {
+         input = arg;
+      }
+      else
+      {
+         std::cerr << "Unexpected argument " << arg << ". " << usage << std::endl;
+         return EXIT_FAILURE;
+      }
+   }
+
+   if (input.empty())
+   {
+      std::cerr << "Wrong number of arguments. " << usage << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   ED::Graph graph = ED::Graph::build_graph(input, num_threads);
+   options.num_threads = num_threads;
+
+   // The deadline counts from the start of the search. SIGTERM stops the search like the deadline, SIGUSR1 only
+   // writes a checkpoint.
+   if (time_limit > 0)
+   {
+      options.deadline = std::chrono::steady_clock::now() +
+                         std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                            std::chrono::duration<double>(time_limit));
+   }
+   options.stop = &stop_requested;
+   std::signal(SIGTERM, request_stop);
+   if (not options.checkpoint.empty())
+   {
+      options.checkpoint_request = &checkpoint_requested;
+      std::signal(SIGUSR1, request_checkpoint);
+   }
+
+   // The matching of an earlier run (in either output format), whose edges that still fit the graph are kept.
+   ED::Graph warm_start_matching(0);
+   if (not warm_start.empty())
+   {
+      warm_start_matching = ED::read_matching(warm_start);
+      options.warm_start = &warm_start_matching;
+   }
+
+   if (epsilon != 0 and not certificate.empty())
    {
-      std::cerr << "Wrong number of arguments. Program call: <program_name> <input_graph>" << std::endl;
+      std::cerr << "An approximate matching has no certificate. " << usage << std::endl;
       return EXIT_FAILURE;
    }
 
-   ED::Graph graph = ED::Graph::build_graph(argv[1]);
+   ED::MatchingStatistics stats;
+   std::vector<ED::NodeId> mates;
+   if (epsilon != 0)
+   {
+      // Only augmenting paths up to a length bounded by epsilon are searched, the other options of the exact solver
+      // do not apply.
+      ED::ApproximateMatching approximate(graph, ED::matching_edges_for(epsilon), options.initialization);
+      mates = approximate.mates();
+      std::cerr << "c approximate: " << approximate.size() << " edges, at least " << approximate.guaranteed_ratio()
+                << " of the maximum (at most " << approximate.upper_bound() << " edges); augmenting paths up to "
+                << 2 * ED::matching_edges_for(epsilon) + 1 << " edges" << std::endl;
+      if (print_stats)
+      {
+         ED::ApproximateStatistics const &approximate_stats = approximate.statistics();
+         std::cerr << "c initial matching: " << approximate_stats.initial_size << " of " << approximate.size()
+                   << " edges" << std::endl;
+         std::cerr << "c rounds: " << approximate_stats.rounds << ", searches: " << approximate_stats.searches
+                   << ", augmentations: " << approximate_stats.augmentations
+                   << ", tree nodes: " << approximate_stats.tree_nodes
+                   << ", removed nodes: " << approximate_stats.removed_nodes << std::endl;
+      }
+   }
+   else
+   {
+      mates = ED::EdmondsMatching::get_mates(graph, options, &stats);
+   }
+   ED::Graph matching = ED::matching_graph(mates);
+
+   if (stats.interrupted)
+   {
+      std::cerr << "c interrupted: the matching need not be maximum"
+                << (options.checkpoint.empty() ? "" : ", the search can be resumed from " + options.checkpoint)
+                << (certificate.empty() ? "" : "; no certificate written") << std::endl;
+   }
+
+   if (not certificate.empty() and not stats.interrupted)
+   {
+      // A Tutte-Berge set proving the matching maximum, see verify.cpp.
+      DIMACS::Writer certificate_out(certificate, DIMACS::Writer::Mode::buffered);
+      ED::write_certificate(certificate_out, ED::EdmondsMatching::tutte_berge_set(graph, mates));
+      certificate_out.close();
+   }
+
+   if (print_stats and epsilon == 0)
+   {
+      std::cerr << "c initial matching: " << stats.initial_size << " of " << stats.final_size << " edges" << std::endl;
+      if (not options.checkpoint.empty())
+      {
+         std::cerr << "c checkpoints: " << stats.checkpoints << " written" << std::endl;
+      }
+      if (options.warm_start != nullptr)
+      {
+         std::cerr << "c warm start: " << stats.warm_start_dropped << " edges dropped" << std::endl;
+      }
+      std::cerr << "c scans: " << stats.scans << ", shrinks: " << stats.shrinks
+                << ", augmentations: " << stats.augmentations << ", reset nodes: " << stats.reset_nodes << ", phases: " << stats.phases
+                << ", components: " << stats.components << ", stopped at upper bound: " << stats.bound_stops
+                << (stats.bipartite ? " (bipartite, Hopcroft-Karp)" : "") << (stats.bitsets ? " (bitset adjacency)" : "")
+                << std::endl;
+      if (options.kernelize)
+      {
+         std::cerr << "c reductions: " << stats.reductions.isolated << " isolated, " << stats.reductions.degree_one
+                   << " degree one, " << stats.reductions.degree_two << " degree two; kernel: "
+                   << stats.reductions.kernel_nodes << " nodes, " << stats.reductions.kernel_edges << " edges"
+                   << std::endl;
+      }
+   }
+
+   // Standard output is written with write(2) in large blocks, an output file through a memory mapping.
+   std::unique_ptr<DIMACS::Writer> out;
+   if (output.empty())
+   {
+      out.reset(new DIMACS::Writer(STDOUT_FILENO));
+   }
+   else
+   {
+      out.reset(new DIMACS::Writer(output, DIMACS::Writer::Mode::mapped));
+   }
 
-   ED::Graph matching = ED::EdmondsMatching::get_matching(graph);
+   if (mates_only)
+   {
+      ED::write_mate_array(*out, matching);
+   }
+   else
+   {
+      matching.write_dimacs(*out);
+   }
+   out->close();
 
-   std::cout << matching;
    return EXIT_SUCCESS;
 }
@@ -0,0 +1,79 @@
+#ifndef NODE_MARKER_HPP
+#define NODE_MARKER_HPP
+
+#include "graph.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file node_marker.hpp
+ *
+ * @brief This file provides a reusable set of marked nodes that can be cleared in constant time.
+ */
+namespace ED
+{
+/**
+ * @class NodeMarker
+ *
+ * @brief Marks nodes by stamping them with the current generation. Clearing starts a new generation, so all marks
+ * vanish without touching the array; only on the (very rare) overflow of the generation counter the stamps are
+ * rewritten. Thus marking, testing and clearing cost time proportional to the nodes actually touched.
+ */
+class NodeMarker
+{
+  public:
+    /**
+     * Creates a marker for the nodes 0, ..., n-1 with no node marked.
+     */
+    explicit NodeMarker(NodeId n) : _stamps(n, 0), _generation(1)
+    {
+    }
+
+    /**
+     * Unmarks all nodes.
+     */
+    void clear();
+
+    /**
+     * Marks @c v.
+     */
+    void mark(NodeId v);
+
+    /**
+     * @return True, if @c v has been marked since the last call of @c clear.
+     */
+    bool is_marked(NodeId v) const;
+
+  private:
+    std::vector<std::uint32_t> _stamps;
+    std::uint32_t _generation;
+};
+
+// BEGIN: Inline section
+
+inline void NodeMarker::clear()
+{
+    ++_generation;
+    if (_generation == 0)
+    {
+        std::fill(_stamps.begin(), _stamps.end(), 0);
+        _generation = 1;
+    }
+}
+
+inline void NodeMarker::mark(NodeId v)
+{
+    _stamps[v] = _generation;
+}
+
+inline bool NodeMarker::is_marked(NodeId v) const
+{
+    return _stamps[v] == _generation;
+}
+
+// END: Inline section
+} // namespace ED
+
+#endif // NODE_MARKER_HPP
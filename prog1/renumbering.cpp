@@ -0,0 +1,72 @@
+#include "renumbering.hpp"
+
+#include <stdexcept>
+
+namespace ED
+{
+namespace
+{
+// The neighbors of a Graph as node_order expects them.
+struct Adjacency
+{
+    const Graph &g;
+
+    NodeId num_nodes() const
+    {
+        return g.num_nodes();
+    }
+
+    size_type degree(NodeId v) const
+    {
+        return g.node(v).degree();
+    }
+
+    NodeId neighbor(NodeId v, size_type i) const
+    {
+        return g.node(v).neighbors()[i];
+    }
+};
+} // namespace
+
+NodeRenumbering::NodeRenumbering(const Graph &g, DIMACS::NodeOrder order)
+    : _old_id(DIMACS::node_order(Adjacency{g}, order)), _new_id(DIMACS::inverse_order(_old_id)), _graph(0)
+{
+    GraphBuilder builder(g.num_nodes(), g.num_edges());
+    for (NodeId v = 0; v < g.num_nodes(); ++v)
+    {
+        for (auto w : g.node(_old_id[v]).neighbors())
+        {
+            if (_new_id[w] > v)
+            {
+                builder.add_edge(v, _new_id[w]);
+            }
+        }
+    }
+    _graph = builder.build();
+}
+
+std::vector<NodeId> NodeRenumbering::to_new(const std::vector<NodeId> &mate) const
+{
+    return relabel(mate, _new_id);
+}
+
+std::vector<NodeId> NodeRenumbering::to_old(const std::vector<NodeId> &mate) const
+{
+    return relabel(mate, _old_id);
+}
+
+std::vector<NodeId> NodeRenumbering::relabel(const std::vector<NodeId> &mate, const std::vector<NodeId> &id)
+{
+    if (mate.size() != id.size())
+    {
+        throw std::runtime_error("The mate array does not fit the renumbered graph.");
+    }
+    // Exposed nodes are their own mates, so they stay exposed.
+    std::vector<NodeId> relabeled(mate.size());
+    for (NodeId v = 0; v < mate.size(); ++v)
+    {
+        relabeled[id[v]] = id[mate[v]];
+    }
+    return relabeled;
+}
+} // namespace ED
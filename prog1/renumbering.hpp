@@ -0,0 +1,78 @@
+#ifndef RENUMBERING_HPP
+#define RENUMBERING_HPP
+
+#include "graph.hpp"
+#include "node_order.hpp"
+
+#include <vector>
+
+/**
+ * @file renumbering.hpp
+ *
+ * @brief This file provides the renumbering of a graph in a @c DIMACS::NodeOrder, so that the search accesses the
+ * arrays indexed by node id with better locality.
+ */
+namespace ED
+{
+/**
+ * @class NodeRenumbering
+ *
+ * @brief A copy of a @c Graph with its nodes renumbered in some order, together with the maps between the old and the
+ * new ids. Every edge is added by its endpoint with the smaller new id, so the neighbors of a node are mostly in
+ * increasing order.
+ */
+class NodeRenumbering
+{
+  public:
+    /**
+     * Renumbers @c g in the given order. Takes O(n + m) time and memory for a second copy of the graph.
+     */
+    NodeRenumbering(const Graph &g, DIMACS::NodeOrder order);
+
+    /**
+     * @return The renumbered graph.
+     */
+    const Graph &graph() const;
+
+    NodeId new_id(NodeId old_id) const;
+    NodeId old_id(NodeId new_id) const;
+
+    /**
+     * @return The mate array @c mate of the original graph in new ids.
+     */
+    std::vector<NodeId> to_new(const std::vector<NodeId> &mate) const;
+
+    /**
+     * @return The mate array @c mate of the renumbered graph in old ids.
+     */
+    std::vector<NodeId> to_old(const std::vector<NodeId> &mate) const;
+
+  private:
+    static std::vector<NodeId> relabel(const std::vector<NodeId> &mate, const std::vector<NodeId> &id);
+
+    std::vector<NodeId> _old_id;
+    std::vector<NodeId> _new_id;
+    Graph _graph;
+};
+
+// BEGIN: Inline section
+
+inline const Graph &NodeRenumbering::graph() const
+{
+    return _graph;
+}
+
+inline NodeId NodeRenumbering::new_id(NodeId old_id) const
+{
+    return _new_id[old_id];
+}
+
+inline NodeId NodeRenumbering::old_id(NodeId new_id) const
+{
+    return _old_id[new_id];
+}
+
+// END: Inline section
+} // namespace ED
+
+#endif // RENUMBERING_HPP
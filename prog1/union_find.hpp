@@ -0,0 +1,96 @@
+#ifndef UNION_FIND_HPP
+#define UNION_FIND_HPP
+
+#include "graph.hpp"
+
+#include <vector>
+
+/**
+ * @file union_find.hpp
+ *
+ * @brief This file provides a disjoint-set forest over the nodes of a graph with union by size and path compression.
+ */
+namespace ED
+{
+/**
+ * @class UnionFind
+ *
+ * @brief Partitions the ids 0, ..., n-1 into disjoint sets, each identified by one of its members (its
+ * representative). All operations take amortized nearly constant time.
+ */
+class UnionFind
+{
+  public:
+    /**
+     * Creates n singleton sets.
+     */
+    explicit UnionFind(NodeId n) : _parent(n), _size(n, 1)
+    {
+        for (NodeId v = 0; v < n; ++v)
+        {
+            _parent[v] = v;
+        }
+    }
+
+    /**
+     * @return The representative of the set containing @c v.
+     */
+    NodeId find(NodeId v);
+
+    /**
+     * Merges the sets containing @c a and @c b.
+     * @return The representative of the merged set.
+     */
+    NodeId unite(NodeId a, NodeId b);
+
+    /**
+     * Makes @c v a singleton again.
+     * @warning Only valid if the whole set of @c v is reset, since other members may point to @c v.
+     */
+    void reset(NodeId v);
+
+  private:
+    std::vector<NodeId> _parent;
+    std::vector<size_type> _size;
+};
+
+// BEGIN: Inline section
+
+inline NodeId UnionFind::find(NodeId v)
+{
+    // Path halving: let every other node on the way point to its grandparent.
+    while (_parent[v] != v)
+    {
+        _parent[v] = _parent[_parent[v]];
+        v = _parent[v];
+    }
+    return v;
+}
+
+inline NodeId UnionFind::unite(NodeId a, NodeId b)
+{
+    a = find(a);
+    b = find(b);
+    if (a == b)
+    {
+        return a;
+    }
+    if (_size[a] < _size[b])
+    {
+        std::swap(a, b);
+    }
+    _parent[b] = a;
+    _size[a] += _size[b];
+    return a;
+}
+
+inline void UnionFind::reset(NodeId v)
+{
+    _parent[v] = v;
+    _size[v] = 1;
+}
+
+// END: Inline section
+} // namespace ED
+
+#endif // UNION_FIND_HPP
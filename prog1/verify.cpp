@@ -0,0 +1,32 @@
+#include <iostream>
+#include <cstdlib>
+
+#include "certificate.hpp"
+#include "graph.hpp"
+#include "initial_matching.hpp"
+
+/**
+   Checks a matching written by @c edmonds.out against its graph and proves it maximum with the Tutte-Berge set written
+   by <tt>edmonds.out --certificate</tt>, in time linear in the size of the graph.
+**/
+int main(int argc, char **argv)
+{
+   if (argc != 4)
+   {
+      std::cerr << "Wrong number of arguments. Program call: <program_name> <input_graph> <matching> <certificate>"
+                << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   ED::Graph const graph = ED::Graph::build_graph(argv[1]);
+   ED::Graph const matching = ED::read_matching(argv[2]);
+   ED::CertificateCheck const check = ED::check_certificate(graph, matching, ED::read_certificate(argv[3]));
+
+   if (not check.valid)
+   {
+      std::cout << "Certificate rejected: " << check.error << std::endl;
+      return EXIT_FAILURE;
+   }
+   std::cout << "Certificate verified: the matching with " << check.matching_size << " edges is maximum." << std::endl;
+   return EXIT_SUCCESS;
+}
@@ -1,33 +1,90 @@
 #include "graph.hpp"   // always include corresponding header first
 
-#include <fstream>
+#include "binary_graph.hpp"
+#include "dimacs_parser.hpp"
+#include "dimacs_writer.hpp"
+#include "mapped_file.hpp"
+#include "parallel.hpp"
+
+#include <istream>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace MMWC
 {
 /////////////////////////////////////////////
-//! \c Node definitions
+//! \c Graph definitions
 /////////////////////////////////////////////
 
-void Node::add_neighbor(EdgeId edge_id)
+static_assert(std::is_trivially_copyable<Edge>::value, "Edges are stored in binary caches as they are.");
+
+namespace
+{
+std::size_t capacitated_payload_size(DIMACS::BinaryHeader const &header)
 {
-    _incident_edges.push_back(edge_id);
+    return DIMACS::aligned_size((header.num_nodes + 1) * sizeof(size_type)) +
+           DIMACS::aligned_size(2 * header.num_edges * sizeof(EdgeId)) +
+           DIMACS::aligned_size(header.num_edges * sizeof(Edge));
 }
+}   // namespace
 
-/////////////////////////////////////////////
-//! \c Graph definitions
-/////////////////////////////////////////////
+Graph Graph::build_graph(const std::string &filename, unsigned num_threads)
+{
+    if (DIMACS::is_binary_path(filename))
+    {
+        return load_binary(filename);
+    }
 
-Graph Graph::build_graph(const std::string &filename)
+    std::string cache =
+        DIMACS::find_fresh_cache(filename, DIMACS::BinaryKind::capacitated, sizeof(NodeId));
+    if (!cache.empty())
+    {
+        return load_binary(cache);
+    }
+
+    return parse_dimacs(filename, num_threads);
+}
+
+Graph Graph::parse_dimacs(const std::string &filename, unsigned num_threads)
 {
-    std::ifstream ifs(filename);
-    if (!ifs.is_open())
+    DIMACS::MappedFile file(filename);
+    DIMACS::Parser header_parser(file.begin(), file.end());
+
+    std::size_t num_nodes = 0;
+    std::size_t num_edges = 0;
+    header_parser.read_problem_line(num_nodes, num_edges);
+    DIMACS::check_id_range(num_nodes, "nodes");
+    DIMACS::check_id_range(num_edges, "edges");
+
+    const auto chunks = DIMACS::split_lines(header_parser.position(), file.end(),
+                                            DIMACS::resolve_thread_count(num_threads));
+    std::vector<GraphBuilder> parts;
+    parts.reserve(chunks.size());
+    for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk)
     {
-        throw std::runtime_error("Could not open input file.");
+        parts.emplace_back(num_nodes, num_edges / chunks.size() + 1);
     }
 
+    DIMACS::run_parallel(chunks.size(), [&chunks, &parts](unsigned chunk) {
+        DIMACS::Parser parser(chunks[chunk].first, chunks[chunk].second);
+        DimacsId i;
+        DimacsId j;
+        long cap;
+        while (parser.next_edge(i, j, cap))
+        {
+            parts[chunk].add_edge(from_dimacs_id(i), from_dimacs_id(j),
+                                  static_cast<capacity>(cap));
+        }
+    });
+
+    return GraphBuilder::build(parts);
+}
+
+Graph Graph::build_graph(std::istream &ifs)
+{
     std::string line;
 
     do
@@ -53,7 +110,7 @@ Graph Graph::build_graph(const std::string &filename)
         throw std::runtime_error("Unexpected format of input file.");
     }
 
-    Graph graph(num_nodes);
+    GraphBuilder builder(num_nodes, num_edges);
     while (std::getline(ifs, line))
     {
         if (line.empty() or line[0] != 'e')
@@ -67,26 +124,108 @@ Graph Graph::build_graph(const std::string &filename)
         DimacsId j;
         capacity cap;
         stream >> c >> i >> j >> cap;
-        graph.add_edge(from_dimacs_id(i), from_dimacs_id(j), cap);
+        builder.add_edge(from_dimacs_id(i), from_dimacs_id(j), cap);
+    }
+
+    return builder.build();
+}
+
+Graph Graph::load_binary(const std::string &filename)
+{
+    auto file = DIMACS::map_binary(filename, DIMACS::BinaryKind::capacitated, sizeof(NodeId),
+                                   sizeof(Edge), capacitated_payload_size);
+    auto const &header = DIMACS::binary_header(*file);
+
+    const std::size_t incident_start =
+        DIMACS::aligned_size((header.num_nodes + 1) * sizeof(size_type));
+    const std::size_t edges_start =
+        incident_start + DIMACS::aligned_size(2 * header.num_edges * sizeof(EdgeId));
+
+    const size_type *offsets = DIMACS::binary_array<size_type>(*file, 0);
+    const EdgeId *incident_edges = DIMACS::binary_array<EdgeId>(*file, incident_start);
+    const Edge *edges = DIMACS::binary_array<Edge>(*file, edges_start);
+    DIMACS::check_id_range(header.num_nodes, "nodes");
+    DIMACS::check_id_range(header.num_edges, "edges");
+    DIMACS::check_csr(offsets, header.num_nodes, incident_edges, 2 * header.num_edges,
+                      header.num_edges);
+    for (std::uint64_t e = 0; e < header.num_edges; ++e)
+    {
+        if (edges[e].from >= header.num_nodes || edges[e].to >= header.num_nodes ||
+            edges[e].from == edges[e].to)
+        {
+            throw std::runtime_error("Binary graph file is corrupt.");
+        }
     }
 
-    return graph;
+    return Graph(file, static_cast<NodeId>(header.num_nodes),
+                 static_cast<size_type>(header.num_edges), offsets, incident_edges, edges);
 }
 
-Graph::Graph(NodeId const num_nodes) : _nodes(num_nodes), _edges() {}
+Graph::Graph(NodeId const num_nodes)
+    : Graph(std::make_shared<const Arrays>(
+          Arrays{std::vector<size_type>(num_nodes + 1, 0), {}, {}}))
+{}
+
+Graph::Graph(std::shared_ptr<const Arrays> const &arrays)
+    : Graph(arrays, arrays->offsets.size() - 1, arrays->edges.size(), arrays->offsets.data(),
+            arrays->incident_edges.data(), arrays->edges.data())
+{}
 
-void Graph::add_edge(NodeId node1_id, NodeId node2_id, capacity cap)
+Graph::Graph(std::shared_ptr<const void> storage,
+             NodeId num_nodes,
+             size_type num_edges,
+             const size_type *offsets,
+             const EdgeId *incident_edges,
+             const Edge *edges)
+    : _storage(std::move(storage)), _num_nodes(num_nodes), _num_edges(num_edges),
+      _offsets(offsets), _incident_edges(incident_edges), _edges(edges)
+{}
+
+Graph Graph::renumbered(const std::vector<NodeId> &new_id) const
 {
-    if (node1_id == node2_id)
+    if (new_id.size() != _num_nodes)
     {
-        throw std::runtime_error("ED::Graph class does not support loops!");
+        throw std::runtime_error("The renumbering does not fit the graph.");
     }
+    GraphBuilder builder(_num_nodes, _num_edges);
+    for (const auto &edge : get_edges())
+    {
+        builder.add_edge(new_id[edge.from], new_id[edge.to], edge.cap);
+    }
+    return builder.build();
+}
 
-    _edges.push_back({node1_id, node2_id, cap});
+void Graph::write_binary_cache(const std::string &dmx_filename) const
+{
+    auto header = DIMACS::make_header(DIMACS::BinaryKind::capacitated, sizeof(NodeId),
+                                      sizeof(Edge), _num_nodes, _num_edges,
+                                      DIMACS::source_stamp(dmx_filename));
+    DIMACS::write_binary(DIMACS::binary_cache_path(dmx_filename), header,
+                         {{_offsets, (_num_nodes + 1) * sizeof(size_type)},
+                          {_incident_edges, 2 * _num_edges * sizeof(EdgeId)},
+                          {_edges, _num_edges * sizeof(Edge)}});
+}
 
-    const EdgeId edge_id = _edges.size() - 1;
-    _nodes.at(node1_id).add_neighbor(edge_id);
-    _nodes.at(node2_id).add_neighbor(edge_id);
+void Graph::write_dimacs(DIMACS::Writer &out) const
+{
+    out.put("c This encodes a graph in DIMACS format\n");
+    out.put("p edge ");
+    out.put_unsigned(_num_nodes);
+    out.put(' ');
+    out.put_unsigned(_num_edges);
+    out.put('\n');
+
+    // Endpoints are valid nodes, so adding 1 cannot overflow.
+    for (const auto &edge: get_edges())
+    {
+        out.put("e ");
+        out.put_unsigned(edge.from + 1);
+        out.put(' ');
+        out.put_unsigned(edge.to + 1);
+        out.put(' ');
+        out.put_signed(edge.cap);
+        out.put('\n');
+    }
 }
 
 std::ostream &operator<<(std::ostream &str, Graph const &graph)
@@ -94,7 +233,7 @@ std::ostream &operator<<(std::ostream &str, Graph const &graph)
     str << "c This encodes a graph in DIMACS format\n"
         << "p edge " << graph.num_nodes() << " " << graph.num_edges() << "\n";
 
-    for (const auto &edge: graph._edges)
+    for (const auto &edge: graph.get_edges())
     {
         str << "e " << to_dimacs_id(edge.from) << " " << to_dimacs_id(edge.to) << " "
             << edge.cap << "\n";
@@ -104,6 +243,140 @@ std::ostream &operator<<(std::ostream &str, Graph const &graph)
     return str;
 }
 
+namespace
+{
+// The neighbors of a Graph as DIMACS::node_order expects them.
+struct Adjacency
+{
+    const Graph &g;
+
+    NodeId num_nodes() const { return g.num_nodes(); }
+    size_type degree(NodeId v) const { return g.node(v).degree(); }
+    NodeId neighbor(NodeId v, size_type i) const
+    {
+        return g.get_other_node(g.node(v).incident_edges()[i], v);
+    }
+};
+}   // namespace
+
+std::vector<NodeId> node_order(const Graph &g, DIMACS::NodeOrder order)
+{
+    return DIMACS::node_order(Adjacency{g}, order);
+}
+
+/////////////////////////////////////////////
+//! \c GraphBuilder definitions
+/////////////////////////////////////////////
+
+GraphBuilder::GraphBuilder(NodeId const num_nodes, size_type const expected_num_edges)
+    : _num_nodes(num_nodes), _edges()
+{
+    _edges.reserve(expected_num_edges);
+}
+
+void GraphBuilder::add_edge(NodeId node1_id, NodeId node2_id, capacity cap)
+{
+    if (node1_id == node2_id)
+    {
+        throw std::runtime_error("MMWC::Graph class does not support loops!");
+    }
+    if (node1_id >= _num_nodes or node2_id >= _num_nodes)
+    {
+        throw std::out_of_range("Edge endpoint is not a node of the graph.");
+    }
+
+    _edges.push_back({node1_id, node2_id, cap});
+}
+
+Graph GraphBuilder::build() const
+{
+    return scatter(this, 1);
+}
+
+Graph GraphBuilder::build(const std::vector<GraphBuilder> &parts)
+{
+    if (parts.empty())
+    {
+        throw std::runtime_error("Cannot build a graph from no parts.");
+    }
+    for (const auto &part: parts)
+    {
+        if (part._num_nodes != parts.front()._num_nodes)
+        {
+            throw std::runtime_error("All parts of a graph need the same number of nodes.");
+        }
+    }
+
+    return scatter(parts.data(), parts.size());
+}
+
+Graph GraphBuilder::scatter(const GraphBuilder *parts, size_type num_parts)
+{
+    const NodeId num_nodes = parts[0]._num_nodes;
+
+    // The edges of part p get the ids following those of all earlier parts. The problem line may understate their
+    // number.
+    size_type num_edges = 0;
+    for (size_type part = 0; part < num_parts; ++part)
+    {
+        num_edges += parts[part]._edges.size();
+    }
+    DIMACS::check_id_range(num_edges, "edges");
+    std::vector<EdgeId> first_edge(num_parts + 1, 0);
+    for (size_type part = 0; part < num_parts; ++part)
+    {
+        first_edge[part + 1] = first_edge[part] + parts[part]._edges.size();
+    }
+
+    auto arrays = std::make_shared<Graph::Arrays>();
+    auto &edges = arrays->edges;
+    edges.resize(first_edge[num_parts]);
+
+    // First pass: every part copies its edges and counts the degrees of their endpoints.
+    std::vector<std::vector<size_type>> next(num_parts);
+    DIMACS::run_parallel(num_parts, [parts, num_nodes, &first_edge, &edges, &next](unsigned part) {
+        next[part].assign(num_nodes, 0);
+        EdgeId edge_id = first_edge[part];
+        for (const auto &edge: parts[part]._edges)
+        {
+            edges[edge_id++] = edge;
+            ++next[part][edge.from];
+            ++next[part][edge.to];
+        }
+    });
+
+    // Prefix sum over (node, part): the slots of a node are handed out to the parts in
+    // order, so the incident edges end up sorted by edge id as with a single builder.
+    auto &offsets = arrays->offsets;
+    offsets.resize(num_nodes + 1);
+    size_type sum = 0;
+    for (NodeId node_id = 0; node_id < num_nodes; ++node_id)
+    {
+        offsets[node_id] = sum;
+        for (size_type part = 0; part < num_parts; ++part)
+        {
+            const size_type degree = next[part][node_id];
+            next[part][node_id] = sum;
+            sum += degree;
+        }
+    }
+    offsets[num_nodes] = sum;
+
+    // Second pass: every part scatters its edge ids into the slots reserved for it.
+    auto &incident_edges = arrays->incident_edges;
+    incident_edges.resize(sum);
+    DIMACS::run_parallel(num_parts, [&first_edge, &edges, &next, &incident_edges](unsigned part) {
+        auto &slot = next[part];
+        for (EdgeId edge_id = first_edge[part]; edge_id < first_edge[part + 1]; ++edge_id)
+        {
+            incident_edges[slot[edges[edge_id].from]++] = edge_id;
+            incident_edges[slot[edges[edge_id].to]++] = edge_id;
+        }
+    });
+
+    return Graph(arrays);
+}
+
 /////////////////////////////////////////////
 //! global functions
 /////////////////////////////////////////////
@@ -114,6 +387,8 @@ NodeId from_dimacs_id(DimacsId const dimacs_id)
     {
         throw std::runtime_error("Invalid (0) DIMACS id.");
     }
+    // Larger ids would wrap around to valid nodes.
+    DIMACS::check_id_range(dimacs_id, "nodes");
 
     return static_cast<NodeId>(dimacs_id - 1);
 }
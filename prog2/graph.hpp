@@ -4,15 +4,26 @@
 /**
    @file graph.hpp
 
-   @brief This file provides a simple class @c Graph to model unweighted undirected
-graphs.
+   @brief This file provides a simple immutable class @c Graph to model undirected graphs
+with edge capacities.
 **/
 
 #include <cstddef>   // std::size_t
 #include <iosfwd>    // std::ostream fwd declare
 #include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
+#include "index_type.hpp"
+#include "node_order.hpp"
+
+namespace DIMACS
+{
+class Writer;
+}   // namespace DIMACS
+
 namespace MMWC   // for Minimum Mean Weighted Cycle
 {
 using size_type = std::size_t;
@@ -28,9 +39,10 @@ capacity constexpr max_capacity = std::numeric_limits<capacity>::max();
 //! or a custom struct providing cast operator to \c size_type s.t.
 //! mixup of index types is avoided.
 //! This is not done here for simplicity.
-using NodeId = size_type;
+//! Node and edge ids are 32 bits wide if built with DIMACS_INDEX32 (see index_type.hpp).
+using NodeId = DIMACS::Index;
 using DimacsId = size_type;
-using EdgeId = size_type;
+using EdgeId = DIMACS::Index;
 
 /** Useful constant different from the id of any actual node: **/
 NodeId constexpr invalid_node_id = std::numeric_limits<NodeId>::max();
@@ -44,7 +56,7 @@ between the two models clear (instead of just having some unexplained -1's and +
 middle of the code.
 **/
 NodeId from_dimacs_id(
-    DimacsId const dimacs_id);   //!< Subtracts 1 (throws if @c dimacs_id is 0)
+    DimacsId const dimacs_id);   //!< Subtracts 1 (throws if @c dimacs_id is 0 or too large)
 DimacsId
     to_dimacs_id(NodeId const node_id);   //!< Adds 1 (throws if overflow would occur)
 
@@ -57,12 +69,40 @@ struct Edge
     NodeId other(NodeId node_id) const;
 };
 
+/**
+   @class ArrayRange
+
+   @brief A read-only view of a contiguous array, usable in range-based for loops.
+**/
+template <typename T>
+class ArrayRange
+{
+  public:
+    typedef std::size_t size_type;
+    typedef const T *const_iterator;
+
+    ArrayRange(const_iterator begin, const_iterator end) : _begin(begin), _end(end) {}
+
+    const_iterator begin() const { return _begin; }
+    const_iterator end() const { return _end; }
+
+    size_type size() const { return static_cast<size_type>(_end - _begin); }
+    bool empty() const { return _begin == _end; }
+
+    const T &operator[](size_type i) const { return _begin[i]; }
+
+  private:
+    const_iterator _begin;
+    const_iterator _end;
+};
+
 /**
    @class Node
 
-   @brief A @c Node stores an array of neighbors (via their ids).
+   @brief A @c Node is a lightweight view of the incident edges of one node in a @c Graph
+(via their ids). It is only valid as long as the @c Graph it was obtained from.
 
-   @note The neighbors are not necessarily ordered, so searching for a specific neighbor
+   @note The edges are not necessarily ordered, so searching for a specific neighbor
 takes O(degree)-time.
 **/
 class Node
@@ -70,39 +110,33 @@ class Node
   public:
     typedef std::size_t size_type;
 
-    /** @brief Create an isolated node (you can add neighbors later). **/
-    Node() = default;
-
-    /** @return The number of neighbors of this node. **/
+    /** @return The number of incident edges of this node. **/
     size_type degree() const;
 
-    /** @return The array of ids of the neighbors of this node. **/
-    std::vector<EdgeId> const &incident_edges() const;
+    /** @return The array of ids of the incident edges of this node. **/
+    ArrayRange<EdgeId> incident_edges() const;
 
   private:
     friend class Graph;
 
-    /**
-       @brief Adds @c id to the list of neighbors of this node.
-       @warning Does not check whether @c id is already in the list of neighbors (a
-    repeated neighbor is legal, and models parallel edges).
-       @warning Does not check whether @c id is the identity of the node itself (which
-    would create a loop!).
-    **/
-    void add_neighbor(EdgeId edge_id);
+    explicit Node(ArrayRange<EdgeId> incident_edges);
 
-    std::vector<EdgeId> _incident_edges;
+    ArrayRange<EdgeId> _incident_edges;
 };   // class Node
 
 /**
    @class Graph
 
-   @brief A @c Graph stores an array of @c Node s, but no array of edges. The list of
-edges is implicitly given by the fact that the nodes know their neighbors.
+   @brief A @c Graph stores an array of @c Edge s and, in compressed sparse row (CSR)
+form, the ids of the edges incident to every node: the incident edges of node @c v are
+the entries <tt> [offsets[v], offsets[v + 1]) </tt> of one shared array.
+
+   A @c Graph is immutable, use a @c GraphBuilder to create one edge by edge. Copies
+share the same arrays, which are either owned by the graph or live in a memory-mapped
+binary cache (@c .dmxb, see binary_graph.hpp).
 
-   This class models undirected graphs only (in the sense that the method @c
-add_edge(node1, node2) adds both @c node1 as a neighbor of @c node2 and @c node2 as a
-neighbor of @c node1). It also forbids loops, but parallel edges are legal.
+   This class models undirected graphs only. It forbids loops, but parallel edges are
+legal.
 
    @warning Nodes are numbered starting at 0, as is usually done in programming,
     instead starting at 1, as is done in the DIMACS format that your program should take
@@ -115,16 +149,42 @@ class Graph
 
     /**
        @brief Creates the graph from the given file in DIMACS format.
+
+       If @c filename ends with @c .dmxb, it is loaded as a binary cache. Otherwise, if
+    a fresh binary cache of the file exists next to it, the cache is loaded instead of
+    parsing the text.
+       @param num_threads The number of threads used to parse text (see @c parse_dimacs).
     **/
-    static Graph build_graph(const std::string &filename);
+    static Graph build_graph(const std::string &filename, unsigned num_threads = 1);
 
     /**
-       @brief Creates a @c Graph with @c num_nodes isolated nodes.
+       @brief Parses the given file in DIMACS format, ignoring any binary cache.
+
+       The file is memory-mapped and parsed without per-line allocations. With more than
+    one thread, the edge lines are split into chunks at line boundaries, every thread
+    parses one chunk into its own edge buffer, and the buffers are merged by a parallel
+    prefix-sum scatter. The result does not depend on the number of threads.
+       @param num_threads The number of threads to use, 0 means one per hardware thread.
+    **/
+    static Graph parse_dimacs(const std::string &filename, unsigned num_threads = 1);
+
+    /**
+       @brief Creates the graph from a DIMACS stream that cannot be mapped (e.g. a
+    pipe). This line-by-line path is considerably slower than the file-based overload.
+    **/
+    static Graph build_graph(std::istream &is);
+
+    /**
+       @brief Loads a binary cache written by @c write_binary_cache by mapping it. Throws
+    if its arrays or edges are inconsistent (see @c DIMACS::check_csr), which takes one pass
+    over them.
+    **/
+    static Graph load_binary(const std::string &filename);
 
-       The number of nodes in the graph currently cannot be changed. You can only add
-    edges between the existing nodes.
+    /**
+       @brief Creates a @c Graph with @c num_nodes isolated nodes.
     **/
-    Graph(NodeId const num_nodes);
+    explicit Graph(NodeId const num_nodes);
 
     /** @return The number of nodes in the graph. **/
     NodeId num_nodes() const;
@@ -133,37 +193,124 @@ class Graph
     size_type num_edges() const;
 
     /**
-       @return A reference to the id-th entry in the array of @c Node s of this graph.
+       @return A view of the id-th node of this graph.
+    **/
+    Node node(NodeId const id) const;
+
+    capacity get_capacity(EdgeId edge_id) const;
+
+    NodeId get_other_node(EdgeId edge_id, NodeId node_id) const;
+
+    ArrayRange<Edge> get_edges() const;
+
+    /**
+       @return A copy of this graph in which node @c v has the id <tt>new_id[v]</tt>, which
+    has to be a permutation of the node ids. The edges keep their ids, order and capacities,
+    so results given by edge ids need no mapping back.
     **/
-    Node const &node(NodeId const id) const;
+    Graph renumbered(const std::vector<NodeId> &new_id) const;
 
     /**
-       @brief Adds the edge <tt> {node1_id, node2_id} </tt> to this graph.
+       @brief Writes this graph as the binary cache of the DIMACS file @c dmx_filename
+    it was read from, i.e. next to it and stamped with its current size and modification
+    time.
+    **/
+    void write_binary_cache(const std::string &dmx_filename) const;
+
+    /**
+       @brief Writes the graph in DIMACS format, the same text as @c operator<< produces,
+    but much faster.
+    **/
+    void write_dimacs(DIMACS::Writer &out) const;
 
-       Checks that @c node1_id and @c node2_id are distinct and throws an exception
-    otherwise. This method adds both @c node1_id as a neighbor of @c node2_id and @c
-    node2_id as a neighbor of @c node1_id.
+    /**
+      @brief Prints the graph to the given ostream in DIMACS format.
+    **/
+    friend std::ostream &operator<<(std::ostream &str, Graph const &graph);
+
+  private:
+    friend class GraphBuilder;
+
+    //! The arrays of a graph that owns its memory.
+    struct Arrays
+    {
+        std::vector<size_type> offsets;
+        std::vector<EdgeId> incident_edges;
+        std::vector<Edge> edges;
+    };
+
+    explicit Graph(std::shared_ptr<const Arrays> const &arrays);
+
+    Graph(std::shared_ptr<const void> storage,
+          NodeId num_nodes,
+          size_type num_edges,
+          const size_type *offsets,
+          const EdgeId *incident_edges,
+          const Edge *edges);
+
+    std::shared_ptr<const void> _storage;   //!< Keeps the arrays below alive.
+    NodeId _num_nodes;
+    size_type _num_edges;
+    const size_type *_offsets;
+    const EdgeId *_incident_edges;
+    const Edge *_edges;
+};   // class Graph
+
+/**
+   @class GraphBuilder
+
+   @brief Collects the edges of a @c Graph and then lays out its CSR incidence lists in
+two passes: the first counts the degrees, the second scatters every edge id into the
+slots reserved for its endpoints. Incident edges keep the order in which they were added.
+**/
+class GraphBuilder
+{
+  public:
+    typedef std::size_t size_type;
+
+    /**
+       @brief Prepares a graph with @c num_nodes isolated nodes.
+       @param expected_num_edges Used to reserve memory only (e.g. the edge count of a
+    DIMACS problem line).
+    **/
+    explicit GraphBuilder(NodeId const num_nodes, size_type const expected_num_edges = 0);
+
+    /** @return The number of nodes in the graph being built. **/
+    NodeId num_nodes() const;
+
+    /**
+       @brief Adds the edge <tt> {node1_id, node2_id} </tt> with capacity @c cap.
+
+       Checks that @c node1_id and @c node2_id are distinct and existing nodes and
+    throws an exception otherwise.
 
        @warning Does not check that the edge does not already exist, so this class can be
     used to model non-simple graphs.
     **/
     void add_edge(NodeId node1_id, NodeId node2_id, capacity cap);
 
-    capacity get_capacity(EdgeId edge_id) const;
-
-    NodeId get_other_node(EdgeId edge_id, NodeId node_id) const;
-
-    const std::vector<Edge> &get_edges() const;
+    /** @return The @c Graph consisting of all edges added so far. **/
+    Graph build() const;
 
     /**
-      @brief Prints the graph to the given ostream in DIMACS format.
+       @return The @c Graph consisting of the edges of all @c parts, which have to agree
+    on the number of nodes. Edges are numbered as if the parts had been added one after
+    the other. Every part is counted and scattered by its own thread.
     **/
-    friend std::ostream &operator<<(std::ostream &str, Graph const &graph);
+    static Graph build(const std::vector<GraphBuilder> &parts);
 
   private:
-    std::vector<Node> _nodes;
+    static Graph scatter(const GraphBuilder *parts, size_type num_parts);
+
+    NodeId _num_nodes;
     std::vector<Edge> _edges;
-};   // class Graph
+};   // class GraphBuilder
+
+/**
+   @return The nodes of @c g in the given order (see @c DIMACS::node_order), i.e. the new ids
+of @c g.renumbered(DIMACS::inverse_order(nodes)) map back to the old ones by <tt>nodes</tt>.
+**/
+std::vector<NodeId> node_order(const Graph &g, DIMACS::NodeOrder order);
 
 // BEGIN: Inline section
 
@@ -172,45 +319,65 @@ inline NodeId Edge::other(NodeId node_id) const
     return node_id == from ? to : from;
 }
 
+inline Node::Node(ArrayRange<EdgeId> incident_edges) : _incident_edges(incident_edges) {}
+
 inline Node::size_type Node::degree() const
 {
     return incident_edges().size();
 }
 
-inline const std::vector<EdgeId> &Node::incident_edges() const
+inline ArrayRange<EdgeId> Node::incident_edges() const
 {
     return _incident_edges;
 }
 
 inline NodeId Graph::num_nodes() const
 {
-    return _nodes.size();
+    return _num_nodes;
 }
 
 inline Graph::size_type Graph::num_edges() const
 {
-    return _edges.size();
+    return _num_edges;
 }
 
-inline Node const &Graph::node(NodeId const id) const
+inline Node Graph::node(NodeId const id) const
 {
     // perform index checking
-    return _nodes.at(id);
+    if (id >= _num_nodes)
+    {
+        throw std::out_of_range("Invalid node id.");
+    }
+    return Node(ArrayRange<EdgeId>(_incident_edges + _offsets[id],
+                                   _incident_edges + _offsets[id + 1]));
 }
 
 inline capacity Graph::get_capacity(EdgeId edge_id) const
 {
-    return _edges.at(edge_id).cap;
+    if (edge_id >= _num_edges)
+    {
+        throw std::out_of_range("Invalid edge id.");
+    }
+    return _edges[edge_id].cap;
 }
 
 inline NodeId Graph::get_other_node(EdgeId edge_id, NodeId node_id) const
 {
-    return _edges.at(edge_id).other(node_id);
+    if (edge_id >= _num_edges)
+    {
+        throw std::out_of_range("Invalid edge id.");
+    }
+    return _edges[edge_id].other(node_id);
+}
+
+inline ArrayRange<Edge> Graph::get_edges() const
+{
+    return ArrayRange<Edge>(_edges, _edges + _num_edges);
 }
 
-inline const std::vector<Edge> &Graph::get_edges() const
+inline NodeId GraphBuilder::num_nodes() const
 {
-    return _edges;
+    return _num_nodes;
 }
 // END: Inline section
 
@@ -1,7 +1,9 @@
 #include <iostream>
 #include <cstdlib>
 #include <algorithm>
+#include <string>
 
+#include "dimacs_writer.hpp"
 #include "graph.hpp"
 #include "tjoin.hpp"
 #include "mwc.hpp"
@@ -16,7 +18,21 @@ struct blah
 
 int main(int argc, char **argv)
 {
-    if (argc < 2)
+    unsigned num_threads = 1;
+    std::string input;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc)
+        {
+            num_threads = static_cast<unsigned>(std::stoul(argv[++i]));
+        }
+        else
+        {
+            input = arg;
+        }
+    }
+    if (input.empty())
     {
         return 1;
     }
@@ -35,10 +51,12 @@ int main(int argc, char **argv)
     }
     //*/
     //*
-        MMWC::Graph g = MMWC::Graph::build_graph(argv[1]);
+        MMWC::Graph g = MMWC::Graph::build_graph(input, num_threads);
         auto result = MMWC::MinMeanWeightCycle::get_min_mean_cycle(g);
 
-        std::cout << g;
+        DIMACS::Writer out(1);   // stdout
+        g.write_dimacs(out);
+        out.close();
 
         /*MMWC::TJoin tj(g, 0);
 
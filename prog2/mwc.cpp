@@ -110,7 +110,7 @@ Graph MinMeanWeightCycle::populate(std::vector<EdgeId> edges) const
 {
     std::vector<size_t> deg(_g.num_nodes(), 0);
 
-    Graph g(_g.num_nodes());
+    GraphBuilder g(_g.num_nodes(), edges.size());
     for(auto edge_id : edges)
     {
         auto edge = _g.get_edges()[edge_id];
@@ -123,7 +123,7 @@ Graph MinMeanWeightCycle::populate(std::vector<EdgeId> edges) const
         assert(i % 2 == 0);
     }
 
-    return g;
+    return g.build();
 }
 
 } // namespace MMWC